@@ -0,0 +1,126 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <algorithm>
+#include <atomic>
+#include <iosfwd>
+#include <cstdint>
+#include <cstddef>
+
+/*
+ * bench.h — mygame_bench 的微基准框架。
+ *
+ * 说明：
+ * - 每个基准组用 BENCH_GROUP(name, fn) 在静态初始化时注册（与 REGISTER_ROOM 相同的方式），
+ *   bench_main.cpp 按注册顺序运行各组并把结果以 JSON 写到标准输出或 --out 指定的文件。
+ * - Runner::Measure 先执行 warmup 次不计时的调用，再对 body 逐次计时；prepare 在每次调用前执行且不计时，
+ *   用于推进被测对象的状态（例如挪动动态物体，避免其被自动升级为静态）。
+ * - 结果记录每次调用的平均/中位/最小/最大纳秒数；items 为每次调用处理的元素数（如物体数），
+ *   JSON 中同时给出 ns_per_item 以便不同规模之间比较。
+ * - Runner::Expect 用于组内的正确性检查（回归用例）：失败时立即输出到 stderr，全部运行结束后 mygame_bench 以非零值退出。
+ */
+namespace Bench {
+
+	struct Param {
+		std::string key;
+		std::string value;
+		bool numeric = false;
+
+		Param(std::string k, const char* v) : key(std::move(k)), value(v), numeric(false) {}
+		Param(std::string k, std::string v) : key(std::move(k)), value(std::move(v)), numeric(false) {}
+		Param(std::string k, long long v) : key(std::move(k)), value(std::to_string(v)), numeric(true) {}
+		Param(std::string k, int v) : Param(std::move(k), static_cast<long long>(v)) {}
+		Param(std::string k, size_t v) : Param(std::move(k), static_cast<long long>(v)) {}
+	};
+	using Params = std::vector<Param>;
+
+	struct Result {
+		std::string name;
+		Params params;
+		int iterations = 0;
+		size_t items = 1;
+		double ns_mean = 0.0;
+		double ns_median = 0.0;
+		double ns_min = 0.0;
+		double ns_max = 0.0;
+	};
+
+	class Runner {
+	public:
+		// name 中包含 filter 子串的基准才会运行（filter 为空时全部运行）
+		void SetFilter(std::string filter) { m_filter = std::move(filter); }
+		bool Enabled(const std::string& name) const { return m_filter.empty() || name.find(m_filter) != std::string::npos; }
+
+		// 运行环境信息（写入 JSON 的 context 字段）
+		void SetContext(const std::string& key, const std::string& value) { m_context.push_back(Param(key, value)); }
+
+		template <typename Prepare, typename Body>
+		void Measure(const std::string& name, Params params, size_t items, int warmup, int iterations, Prepare&& prepare, Body&& body)
+		{
+			if (!Enabled(name) || iterations <= 0) return;
+			for (int i = 0; i < warmup; ++i) {
+				prepare();
+				body();
+			}
+			std::vector<double> samples;
+			samples.reserve(static_cast<size_t>(iterations));
+			for (int i = 0; i < iterations; ++i) {
+				prepare();
+				const auto t0 = std::chrono::steady_clock::now();
+				body();
+				const auto t1 = std::chrono::steady_clock::now();
+				samples.push_back(std::chrono::duration<double, std::nano>(t1 - t0).count());
+			}
+			Record(name, std::move(params), items, samples);
+		}
+
+		template <typename Body>
+		void Measure(const std::string& name, Params params, size_t items, int warmup, int iterations, Body&& body)
+		{
+			Measure(name, std::move(params), items, warmup, iterations, [] {}, std::forward<Body>(body));
+		}
+
+		// 正确性检查：name 同样受 filter 控制，ok 为 false 时记录一次失败
+		void Expect(const std::string& name, bool ok, const std::string& what);
+		size_t FailureCount() const noexcept { return m_failures; }
+
+		const std::vector<Result>& Results() const noexcept { return m_results; }
+		void WriteJson(std::ostream& os) const;
+
+	private:
+		void Record(const std::string& name, Params params, size_t items, std::vector<double>& samples);
+
+		std::string m_filter;
+		Params m_context;
+		std::vector<Result> m_results;
+		size_t m_failures = 0;
+	};
+
+	using GroupFn = void (*)(Runner&);
+
+	struct Group {
+		const char* name;
+		GroupFn fn;
+	};
+
+	std::vector<Group>& Groups();
+
+	struct GroupRegistrar {
+		GroupRegistrar(const char* name, GroupFn fn) { Groups().push_back(Group{ name, fn }); }
+	};
+
+	// 避免编译器把只为计时而计算的结果优化掉（MSVC/GCC/Clang 通用写法）
+	template <typename T>
+	inline void DoNotOptimize(const T& value) noexcept
+	{
+		static const void* volatile sink = nullptr;
+		sink = &value;
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+	}
+}
+
+#define BENCH_CONCAT_IMPL(x, y) x##y
+#define BENCH_CONCAT(x, y) BENCH_CONCAT_IMPL(x, y)
+#define BENCH_GROUP(NAME, FN) \
+	static const Bench::GroupRegistrar BENCH_CONCAT(bench_group_, __COUNTER__)(NAME, FN)
@@ -0,0 +1,57 @@
+#include "bench.h"
+#include "bench_objects.h"
+#include "delegate.h"
+#include "act_seq.h"
+#include <memory>
+
+extern Delegate<> main_thread_on_update;
+
+// 委托与动作链的分发开销：Delegate::invoke、add/remove，以及 main_thread_on_update 驱动 ActSeq 协程 resume
+namespace {
+
+void RunDispatch(Bench::Runner& runner)
+{
+	for (int handlers : { 1, 16, 256 }) {
+		Delegate<> d;
+		int counter = 0;
+		for (int i = 0; i < handlers; ++i) d.add([&counter]() { ++counter; });
+		runner.Measure("delegate/invoke", { { "handlers", handlers } }, static_cast<size_t>(handlers), 10, 2000, [&] {
+			d.invoke();
+		});
+		Bench::DoNotOptimize(counter);
+	}
+
+	{
+		Delegate<> d;
+		runner.Measure("delegate/add_remove", {}, 1, 100, 20000, [&] {
+			const auto token = d.add([]() {});
+			d.remove(token);
+		});
+	}
+
+	for (int seqs : { 16, 256 }) {
+		constexpr int kWarmup = 10;
+		constexpr int kIterations = 500;
+		std::vector<Bench::BenchBody*> owners = Bench::SpawnBodies({ Bench::BodyDesc{} });
+		std::vector<std::unique_ptr<ActSeq>> sequences;
+		int counter = 0;
+		for (int i = 0; i < seqs; ++i) {
+			auto seq = std::make_unique<ActSeq>();
+			// 单个步骤的帧数恰好覆盖计时区间，结束后协程自行退出并释放
+			seq->add(kWarmup + kIterations, [&counter](BaseObject*, int, int) { ++counter; });
+			seq->play(owners.front());
+			sequences.push_back(std::move(seq));
+		}
+		runner.Measure("actseq/resume", { { "sequences", seqs } }, static_cast<size_t>(seqs), kWarmup, kIterations, [&] {
+			main_thread_on_update();
+		});
+		// 让已结束的协程完成清理
+		for (int i = 0; i < 2; ++i) main_thread_on_update();
+		Bench::DoNotOptimize(counter);
+		ObjManager::Instance().DestroyAll();
+	}
+}
+
+}
+
+BENCH_GROUP("dispatch", RunDispatch);
@@ -0,0 +1,44 @@
+#include "bench.h"
+#include "bench_objects.h"
+#include "drawing_sequence.h"
+
+// DrawingSequence：DrawAll 的命令构建（无图形设备时为记录模式）与 Register/Unregister 的开销
+namespace {
+
+void RunDrawing(Bench::Runner& runner)
+{
+	ObjManager& objs = ObjManager::Instance();
+	DrawingSequence& drawing = DrawingSequence::Instance();
+	const bool gfx = !drawing.IsRecordOnly();
+
+	for (int n : { 1000, 10000 }) {
+		Bench::Rng rng(99u);
+		std::vector<Bench::BodyDesc> descs(static_cast<size_t>(n));
+		for (Bench::BodyDesc& d : descs) {
+			d.pos = cf_v2(rng.Range(-560.0f, 560.0f), rng.Range(-420.0f, 420.0f));
+			d.collider = ColliderType::VOID;
+			d.sprite = "/sprites/common_square.png";
+			d.depth = static_cast<int>(rng.Next() % 4);
+		}
+		std::vector<Bench::BenchBody*> bodies = Bench::SpawnBodies(descs);
+
+		runner.Measure("drawing/draw_all", { { "sprites", n }, { "mode", gfx ? "gfx" : "record" } },
+			static_cast<size_t>(n), 3, 30,
+			[&] {
+				// 上一帧的绘制命令交给渲染器消费，避免命令列表在迭代之间累积
+				if (gfx) Cute::app_draw_onto_screen(true);
+			},
+			[&] { drawing.DrawAll(); });
+		if (gfx) Cute::app_draw_onto_screen(true);
+
+		runner.Measure("drawing/register_churn", { { "sprites", n } }, static_cast<size_t>(n) * 2, 2, 30, [&] {
+			for (Bench::BenchBody* b : bodies) drawing.Unregister(b);
+			for (Bench::BenchBody* b : bodies) drawing.Register(b);
+		});
+		objs.DestroyAll();
+	}
+}
+
+}
+
+BENCH_GROUP("drawing", RunDrawing);
@@ -0,0 +1,170 @@
+#include "bench.h"
+
+#include <atomic>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "delegate.h"
+#include "drawing_sequence.h"
+#include "obj_manager.h"
+#include "headless.h"
+
+// 游戏代码引用的全局变量（mygame 中由 main.cpp 定义）
+std::atomic<int> g_frame_count{ 0 };
+Delegate<> main_thread_on_update;
+int g_frame_rate = 50;
+CF_Audio g_background_music;
+
+namespace {
+	void WriteJsonString(std::ostream& os, const std::string& s)
+	{
+		os << '"';
+		for (char c : s) {
+			switch (c) {
+			case '"': os << "\\\""; break;
+			case '\\': os << "\\\\"; break;
+			case '\n': os << "\\n"; break;
+			case '\t': os << "\\t"; break;
+			default: os << c; break;
+			}
+		}
+		os << '"';
+	}
+
+	void WriteJsonParams(std::ostream& os, const Bench::Params& params)
+	{
+		os << '{';
+		for (size_t i = 0; i < params.size(); ++i) {
+			if (i) os << ", ";
+			WriteJsonString(os, params[i].key);
+			os << ": ";
+			if (params[i].numeric) os << params[i].value;
+			else WriteJsonString(os, params[i].value);
+		}
+		os << '}';
+	}
+}
+
+namespace Bench {
+
+std::vector<Group>& Groups()
+{
+	static std::vector<Group> groups;
+	return groups;
+}
+
+void Runner::Record(const std::string& name, Params params, size_t items, std::vector<double>& samples)
+{
+	Result r;
+	r.name = name;
+	r.params = std::move(params);
+	r.iterations = static_cast<int>(samples.size());
+	r.items = items > 0 ? items : 1;
+	std::sort(samples.begin(), samples.end());
+	double sum = 0.0;
+	for (double s : samples) sum += s;
+	r.ns_mean = sum / static_cast<double>(samples.size());
+	r.ns_median = samples[samples.size() / 2];
+	r.ns_min = samples.front();
+	r.ns_max = samples.back();
+
+	// 进度输出到 stderr，stdout 只保留 JSON
+	std::cerr << std::left << std::setw(32) << r.name;
+	for (const Param& p : r.params) std::cerr << ' ' << p.key << '=' << p.value;
+	std::cerr << std::right << std::fixed << std::setprecision(1)
+		<< "  median=" << r.ns_median / 1000.0 << "us"
+		<< "  per_item=" << r.ns_median / static_cast<double>(r.items) << "ns" << std::endl;
+
+	m_results.push_back(std::move(r));
+}
+
+void Runner::Expect(const std::string& name, bool ok, const std::string& what)
+{
+	if (ok || !Enabled(name)) return;
+	++m_failures;
+	std::cerr << "[Bench] CHECK FAILED " << name << ": " << what << std::endl;
+}
+
+void Runner::WriteJson(std::ostream& os) const
+{
+	os << std::fixed << std::setprecision(1);
+	os << "{\n  \"context\": ";
+	WriteJsonParams(os, m_context);
+	os << ",\n  \"benchmarks\": [\n";
+	for (size_t i = 0; i < m_results.size(); ++i) {
+		const Result& r = m_results[i];
+		os << "    {\"name\": ";
+		WriteJsonString(os, r.name);
+		os << ", \"params\": ";
+		WriteJsonParams(os, r.params);
+		os << ", \"iterations\": " << r.iterations
+			<< ", \"items\": " << r.items
+			<< ", \"ns_mean\": " << r.ns_mean
+			<< ", \"ns_median\": " << r.ns_median
+			<< ", \"ns_min\": " << r.ns_min
+			<< ", \"ns_max\": " << r.ns_max
+			<< ", \"ns_per_item\": " << r.ns_median / static_cast<double>(r.items)
+			<< '}' << (i + 1 < m_results.size() ? ",\n" : "\n");
+	}
+	os << "  ]\n}\n";
+}
+
+}
+
+// 用法：mygame_bench [--filter <子串>] [--out <file.json>] [--no-gfx]
+// - 默认尝试创建隐藏窗口的图形设备，使 DrawAll 真实构建绘制命令；失败或指定 --no-gfx 时退回记录模式
+int main(int argc, char* argv[])
+{
+	Bench::Runner runner;
+	std::string out_path;
+	bool graphics = true;
+	for (int i = 1; i < argc; ++i) {
+		if (std::strcmp(argv[i], "--filter") == 0 && i + 1 < argc) runner.SetFilter(argv[++i]);
+		else if (std::strcmp(argv[i], "--out") == 0 && i + 1 < argc) out_path = argv[++i];
+		else if (std::strcmp(argv[i], "--no-gfx") == 0) graphics = false;
+	}
+
+	if (!(graphics && Headless::InitApp(argv[0], true))) {
+		graphics = false;
+		if (!Headless::InitApp(argv[0], false)) {
+			std::cerr << "[Bench] failed to create app" << std::endl;
+			return -1;
+		}
+	}
+	runner.SetContext("draw_mode", graphics ? "gfx" : "record");
+#if defined(NDEBUG)
+	runner.SetContext("build", "release");
+#else
+	runner.SetContext("build", "debug");
+#endif
+
+	for (const Bench::Group& g : Bench::Groups()) {
+		std::cerr << "[Bench] group " << g.name << std::endl;
+		g.fn(runner);
+		// 各组之间清空对象，保证互不影响
+		ObjManager::Instance().DestroyAll();
+		main_thread_on_update.clear();
+	}
+
+	if (out_path.empty()) {
+		runner.WriteJson(std::cout);
+	}
+	else {
+		std::ofstream file(out_path);
+		if (!file.is_open()) {
+			std::cerr << "[Bench] cannot open " << out_path << std::endl;
+			Headless::ShutdownApp();
+			return -1;
+		}
+		runner.WriteJson(file);
+	}
+	Headless::ShutdownApp();
+	if (runner.FailureCount() > 0) {
+		std::cerr << "[Bench] " << runner.FailureCount() << " check(s) failed" << std::endl;
+		return 1;
+	}
+	return 0;
+}
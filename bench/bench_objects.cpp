@@ -0,0 +1,20 @@
+#include "bench_objects.h"
+
+namespace Bench {
+
+std::vector<BenchBody*> SpawnBodies(const std::vector<BodyDesc>& descs)
+{
+	ObjManager& objs = ObjManager::Instance();
+	std::vector<BenchBody*> bodies;
+	bodies.reserve(descs.size());
+	for (const BodyDesc& d : descs) {
+		ObjManager::ObjToken tok = objs.Create<BenchBody>(d);
+		// pending 对象的地址在提交后保持不变（unique_ptr 只是被移动到 objects_）
+		bodies.push_back(static_cast<BenchBody*>(&objs[tok]));
+	}
+	// 提交 pending 创建：对象进入 objects_ 并注册到物理系统
+	objs.UpdateAll();
+	return bodies;
+}
+
+}
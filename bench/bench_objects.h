@@ -0,0 +1,95 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include "base_object.h"
+
+// 基准测试使用的对象与工具：BenchBody 按描述构造形状/层/静态标志，不依赖任何游戏对象
+namespace Bench {
+
+	enum class BodyShape : uint8_t { Aabb, Circle, Capsule, Poly };
+
+	struct BodyDesc {
+		CF_V2 pos{ 0.0f, 0.0f };
+		BodyShape shape = BodyShape::Aabb;
+		float half = 8.0f;
+		bool is_static = false;
+		ColliderType collider = ColliderType::SOLID;
+		CollisionLayer layer = CollisionLayer::Default;
+		const char* sprite = nullptr; // 非空时加载 sprite 并注册到 DrawingSequence
+		int depth = 0;
+		bool exclude_solids = false;
+		BaseObject::SolidResolveMode resolve_mode = BaseObject::SolidResolveMode::Bisection;
+		float push_down = 0.0f;       // 每帧设置的向下速度（用于持续压入地面以触发排斥）
+	};
+
+	class BenchBody : public BaseObject {
+	public:
+		explicit BenchBody(const BodyDesc& desc) noexcept : BaseObject(), m_desc(desc) {}
+
+		void Start() override
+		{
+			if (m_desc.sprite) SpriteSetSource(m_desc.sprite, 1, false);
+			SetDepth(m_desc.depth);
+			IsColliderRotate(false);
+			IsColliderApplyPivot(false);
+			switch (m_desc.shape) {
+			case BodyShape::Aabb: SetCenteredAabb(m_desc.half, m_desc.half); break;
+			case BodyShape::Circle: SetCenteredCircle(m_desc.half); break;
+			case BodyShape::Capsule: SetCenteredCapsule(cf_v2(0.0f, 1.0f), m_desc.half * 0.5f, m_desc.half * 0.5f); break;
+			case BodyShape::Poly: {
+				const float h = m_desc.half;
+				SetCenteredPoly({ cf_v2(-h, -h), cf_v2(h, -h), cf_v2(h * 0.6f, h), cf_v2(-h * 0.6f, h) });
+				break;
+			}
+			}
+			SetColliderType(m_desc.collider);
+			SetCollisionLayer(m_desc.layer);
+			SetPosition(m_desc.pos);
+			SetStatic(m_desc.is_static);
+			if (m_desc.exclude_solids) {
+				ExcludeWithSolids(true);
+				SetSolidResolveMode(m_desc.resolve_mode);
+			}
+		}
+
+		void Update() override
+		{
+			if (m_desc.push_down > 0.0f) SetVelocityY(-m_desc.push_down);
+		}
+
+		// 轻微挪动（±0.25px 交替），让动态物体保持"正在移动"而不被自动升级为静态
+		void Nudge() noexcept
+		{
+			m_nudge = -m_nudge;
+			SetPosition(GetPosition() + cf_v2(m_nudge, 0.0f));
+		}
+
+		// 提交后的真实 token（基准直接向 PhysicsSystem 注册/注销时使用）
+		const ObjManager::ObjToken& Token() const noexcept { return GetObjToken(); }
+
+	private:
+		BodyDesc m_desc;
+		float m_nudge = 0.25f;
+	};
+
+	// 固定种子的线性同余随机数，保证每次运行生成相同的场景
+	class Rng {
+	public:
+		explicit Rng(uint32_t seed = 12345u) noexcept : m_state(seed) {}
+		uint32_t Next() noexcept
+		{
+			m_state = m_state * 1664525u + 1013904223u;
+			return m_state;
+		}
+		float Range(float lo, float hi) noexcept
+		{
+			return lo + (hi - lo) * static_cast<float>(Next() >> 8) / static_cast<float>(1u << 24);
+		}
+
+	private:
+		uint32_t m_state;
+	};
+
+	// 创建对象并立即提交（一次 UpdateAll），返回对象指针
+	std::vector<BenchBody*> SpawnBodies(const std::vector<BodyDesc>& descs);
+}
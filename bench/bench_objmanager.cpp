@@ -0,0 +1,227 @@
+#include "bench.h"
+#include "bench_objects.h"
+#include "tile_layer.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+// ObjManager：创建 → 提交 → 销毁 的整轮开销、房间重载（DestroyAll + 重新创建）与原地恢复快照的开销，以及空闲对象的每帧 UpdateAll 开销
+namespace {
+
+// 回归检查：pending token 的 index 是 pending 解析槽位，可能与某个存活对象在 objects_ 中的下标相同；
+// 它既不能被 IsValid 当作有效的已注册 token，也不能与该对象的真实 token 相等。
+// 多轮创建/提交/销毁让槽位与 objects_ 下标、代数反复复用，覆盖二者下标相同的情形
+void CheckPendingTokens(Bench::Runner& runner)
+{
+	const char* name = "objmanager/pending_token_check";
+	if (!runner.Enabled(name)) return;
+	ObjManager& objs = ObjManager::Instance();
+	objs.DestroyAll();
+
+	Bench::BodyDesc desc;
+	desc.collider = ColliderType::VOID;
+	std::vector<ObjManager::ObjToken> live;
+	std::vector<ObjManager::ObjToken> pending;
+	for (int round = 0; round < 8; ++round) {
+		pending.clear();
+		for (int i = 0; i < 32; ++i) pending.push_back(objs.Create<Bench::BenchBody>(desc));
+		for (const ObjManager::ObjToken& p : pending) {
+			runner.Expect(name, !objs.IsValid(p), "pending token accepted by IsValid");
+			for (const ObjManager::ObjToken& real : live) {
+				if (p.index == real.index) runner.Expect(name, p != real, "pending token equals a live registered token");
+			}
+		}
+		objs.UpdateAll(); // 提交创建
+		for (ObjManager::ObjToken& p : pending) {
+			runner.Expect(name, objs.TryGetRegisteration(p) && p.isRegitsered, "committed pending token did not resolve");
+			live.push_back(p);
+		}
+		// 销毁一半（隔一个），释放的槽位与下标在下一轮被复用
+		std::vector<ObjManager::ObjToken> kept;
+		for (size_t k = 0; k < live.size(); ++k) {
+			if (k % 2 == 0) objs.Destroy(live[k]);
+			else kept.push_back(live[k]);
+		}
+		objs.UpdateAll(); // 执行延迟销毁
+		live.swap(kept);
+	}
+	objs.DestroyAll();
+}
+
+// 回归检查：TileLayer 的格子在 Create 之后才写入，配方只能重放构造参数。图层偏离（MarkStateDiverged）或格子被改动后
+// RestoreRoomSnapshot 按配方重建，重建出的图层必须带回快照时的格子；重建后的状态被重新记录，下一次恢复应原地保留
+void CheckTileLayerRestore(Bench::Runner& runner)
+{
+	const char* name = "objmanager/tile_restore_check";
+	if (!runner.Enabled(name)) return;
+	ObjManager& objs = ObjManager::Instance();
+	objs.DestroyAll();
+
+	TileLayer* original = nullptr;
+	{
+		ObjManager::RoomScope scope;
+		ObjManager::ObjToken t = objs.Create<TileLayer>(cf_v2(-360.0f, -270.0f), 20, 15, 36.0f, std::vector<std::string>{});
+		original = static_cast<TileLayer*>(&objs[t]);
+		for (int cx = 0; cx < original->Cols(); ++cx) original->SetTile(cx, 0, 0);
+		for (int cy = 1; cy < original->Rows(); ++cy) original->SetTile(cy % original->Cols(), cy, 0);
+		Bench::BodyDesc desc;
+		desc.is_static = true;
+		objs.Create<Bench::BenchBody>(desc);
+	}
+	objs.CaptureRoomSnapshot();
+	objs.UpdateAll(); // 提交创建
+	const size_t expected = original->SolidCellCount();
+
+	// 房间内创建的图层在 arena 中；按配方重建的图层来自对象池，可以用 ForEachOfType 找到
+	auto restore = [&] {
+		runner.Expect(name, objs.RestoreRoomSnapshot(), "RestoreRoomSnapshot refused to restore");
+		objs.UpdateAll(); // 提交重新创建的对象
+		std::vector<TileLayer*> layers;
+		objs.ForEachOfType<TileLayer>([&](TileLayer& t) { layers.push_back(&t); });
+		return layers;
+	};
+
+	// 1) 对象偏离：按配方重建，格子与偏离前一致
+	original->MarkStateDiverged();
+	std::vector<TileLayer*> layers = restore();
+	runner.Expect(name, layers.size() == 1 && layers[0]->SolidCellCount() == expected, "recreated tile layer lost its cells");
+
+	// 2) 重建后的状态已重新记录：再次恢复时原地保留
+	TileLayer* recreated = layers.empty() ? nullptr : layers[0];
+	layers = restore();
+	runner.Expect(name, layers.size() == 1 && layers[0] == recreated, "recreated tile layer was recreated again");
+
+	// 3) 运行中改动格子同样视为偏离，恢复后回到快照时的格子
+	if (recreated) {
+		recreated->SetTile(0, 0, TileLayer::kEmpty);
+		recreated->SetTile(7, 3, 0);
+	}
+	layers = restore();
+	runner.Expect(name, layers.size() == 1 && layers[0]->SolidCellCount() == expected && layers[0]->IsSolid(0, 0) && !layers[0]->IsSolid(7, 3),
+		"restored tile layer kept runtime tile edits");
+	objs.DestroyAll();
+}
+
+void RunObjManager(Bench::Runner& runner)
+{
+	ObjManager& objs = ObjManager::Instance();
+	CheckPendingTokens(runner);
+	CheckTileLayerRestore(runner);
+
+	for (int n : { 100, 1000, 5000 }) {
+		Bench::BodyDesc desc;
+		desc.collider = ColliderType::VOID;
+		std::vector<ObjManager::ObjToken> tokens;
+		tokens.reserve(static_cast<size_t>(n));
+		runner.Measure("objmanager/churn", { { "objects", n } }, static_cast<size_t>(n), 2, n >= 5000 ? 10 : 40, [&] {
+			tokens.clear();
+			Bench::Rng rng(static_cast<uint32_t>(n));
+			for (int i = 0; i < n; ++i) {
+				desc.pos = cf_v2(rng.Range(-500.0f, 500.0f), rng.Range(-400.0f, 400.0f));
+				tokens.push_back(objs.Create<Bench::BenchBody>(desc));
+			}
+			objs.UpdateAll(); // 提交创建
+			for (const ObjManager::ObjToken& t : tokens) objs.Destroy(t);
+			objs.UpdateAll(); // 执行延迟销毁
+		});
+		objs.DestroyAll();
+	}
+
+	// 模拟重生：卸载整个房间再重新创建同样的对象；arena 为 RoomScope 内创建（与 BaseRoom::LoadRoom 相同），pool 为普通创建
+	for (int n : { 500, 5000 }) {
+		std::vector<Bench::BodyDesc> descs(static_cast<size_t>(n));
+		Bench::Rng rng(11u);
+		for (size_t i = 0; i < descs.size(); ++i) {
+			Bench::BodyDesc& d = descs[i];
+			d.pos = cf_v2(rng.Range(-500.0f, 500.0f), rng.Range(-400.0f, 400.0f));
+			d.is_static = (i % 4) != 0; // 房间以静态地形为主
+		}
+		// 与 arena 相同，但通过 CreateBatch 一次性创建
+		runner.Measure("objmanager/room_reload", { { "objects", n }, { "storage", "arena_batch" } },
+			static_cast<size_t>(n), 2, n >= 5000 ? 10 : 40, [&] {
+			objs.DestroyAll();
+			{
+				ObjManager::RoomScope scope;
+				objs.CreateBatch<Bench::BenchBody>(descs);
+			}
+			objs.UpdateAll(); // 提交创建
+		});
+		objs.DestroyAll();
+		for (bool scoped : { true, false }) {
+			runner.Measure("objmanager/room_reload", { { "objects", n }, { "storage", scoped ? "arena" : "pool" } },
+				static_cast<size_t>(n), 2, n >= 5000 ? 10 : 40, [&] {
+				objs.DestroyAll();
+				{
+					std::optional<ObjManager::RoomScope> scope;
+					if (scoped) scope.emplace();
+					for (const Bench::BodyDesc& d : descs) objs.Create<Bench::BenchBody>(d);
+				}
+				objs.UpdateAll(); // 提交创建
+			});
+			objs.DestroyAll();
+		}
+	}
+
+	// 重生两种方式：reload 为整房间卸载再加载，restore 为原地恢复快照（1/4 的动态物体被挪动过，需要重新创建）
+	for (int n : { 500, 5000 }) {
+		std::vector<Bench::BodyDesc> descs(static_cast<size_t>(n));
+		Bench::Rng rng(13u);
+		for (size_t i = 0; i < descs.size(); ++i) {
+			Bench::BodyDesc& d = descs[i];
+			d.pos = cf_v2(rng.Range(-500.0f, 500.0f), rng.Range(-400.0f, 400.0f));
+			d.is_static = (i % 4) != 0;
+		}
+		std::vector<Bench::BenchBody*> dynamic_bodies;
+		auto load_room = [&] {
+			objs.DestroyAll();
+			dynamic_bodies.clear();
+			{
+				ObjManager::RoomScope scope;
+				for (const Bench::BodyDesc& d : descs) {
+					ObjManager::ObjToken t = objs.Create<Bench::BenchBody>(d);
+					if (!d.is_static) dynamic_bodies.push_back(static_cast<Bench::BenchBody*>(&objs[t]));
+				}
+			}
+			objs.CaptureRoomSnapshot();
+			objs.UpdateAll(); // 提交创建
+		};
+		for (bool restore : { false, true }) {
+			load_room();
+			runner.Measure("objmanager/respawn", { { "objects", n }, { "mode", restore ? "restore" : "reload" } },
+				static_cast<size_t>(n), 2, n >= 5000 ? 10 : 40, [&] {
+				if (restore) {
+					for (Bench::BenchBody* b : dynamic_bodies) b->Nudge();
+					objs.RestoreRoomSnapshot();
+					objs.UpdateAll(); // 提交重新创建的对象
+					// 重新创建的对象来自对象池（静态物体仍在 arena 中原地保留）
+					dynamic_bodies.clear();
+					objs.ForEachOfType<Bench::BenchBody>([&](Bench::BenchBody& b) {
+						if (!b.IsStatic()) dynamic_bodies.push_back(&b);
+					});
+				}
+				else {
+					load_room();
+				}
+			});
+			objs.DestroyAll();
+		}
+	}
+
+	for (int n : { 1000, 10000 }) {
+		std::vector<Bench::BodyDesc> descs(static_cast<size_t>(n));
+		Bench::Rng rng(7u);
+		for (Bench::BodyDesc& d : descs) {
+			d.collider = ColliderType::VOID;
+			d.pos = cf_v2(rng.Range(-500.0f, 500.0f), rng.Range(-400.0f, 400.0f));
+		}
+		Bench::SpawnBodies(descs);
+		runner.Measure("objmanager/update_all_idle", { { "objects", n } }, static_cast<size_t>(n), 5, 50, [&] {
+			objs.UpdateAll();
+		});
+		objs.DestroyAll();
+	}
+}
+
+}
+
+BENCH_GROUP("objmanager", RunObjManager);
@@ -0,0 +1,400 @@
+#include "bench.h"
+#include "bench_objects.h"
+#include "tile_layer.h"
+#include <cmath>
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+// PhysicsSystem：不同规模、静态/动态比例与形状组合下单次 Step 的耗时，以及排斥固体（ExclusionWithSolid）的求解开销
+namespace {
+
+const char* ShapeName(int s)
+{
+	switch (s) {
+	case 0: return "aabb";
+	case 1: return "circle";
+	case 2: return "poly";
+	default: return "mixed";
+	}
+}
+
+Bench::BodyShape PickShape(int s, Bench::Rng& rng)
+{
+	switch (s) {
+	case 0: return Bench::BodyShape::Aabb;
+	case 1: return Bench::BodyShape::Circle;
+	case 2: return Bench::BodyShape::Poly;
+	default: return static_cast<Bench::BodyShape>(rng.Next() % 4);
+	}
+}
+
+const char* BroadphaseName(BroadphaseType t)
+{
+	switch (t) {
+	case BroadphaseType::Grid: return "grid";
+	case BroadphaseType::SweepAndPrune: return "sap";
+	default: return "tree";
+	}
+}
+
+// 让每个物体平均占据 40x40 的区域，规模变化时密度保持不变；同时把稠密网格范围设置为该区域
+CF_Aabb ArenaFor(int n)
+{
+	const float half = std::max(0.5f * std::sqrt(static_cast<float>(n)) * 40.0f, 200.0f);
+	return cf_make_aabb(cf_v2(-half, -half), cf_v2(half, half));
+}
+
+void RunStep(Bench::Runner& runner)
+{
+	ObjManager& objs = ObjManager::Instance();
+	PhysicsSystem& physics = PhysicsSystem::Instance();
+	const CF_Aabb saved_bounds = physics.GetWorldBounds();
+
+	for (int n : { 100, 1000, 10000 }) {
+		const CF_Aabb arena = ArenaFor(n);
+		physics.SetWorldBounds(arena);
+		for (int static_pct : { 0, 50, 90 }) {
+			for (int shape : { 0, 1, 2, 3 }) {
+				Bench::Rng rng(static_cast<uint32_t>(n * 131 + static_pct * 7 + shape));
+				std::vector<Bench::BodyDesc> descs(static_cast<size_t>(n));
+				for (size_t i = 0; i < descs.size(); ++i) {
+					Bench::BodyDesc& d = descs[i];
+					d.pos = cf_v2(rng.Range(arena.min.x, arena.max.x), rng.Range(arena.min.y, arena.max.y));
+					d.shape = PickShape(shape, rng);
+					d.half = rng.Range(6.0f, 14.0f);
+					d.is_static = static_cast<int>(i % 100) < static_pct;
+				}
+				std::vector<Bench::BenchBody*> bodies = Bench::SpawnBodies(descs);
+				std::vector<Bench::BenchBody*> dynamic_bodies;
+				for (size_t i = 0; i < bodies.size(); ++i) {
+					if (!descs[i].is_static) dynamic_bodies.push_back(bodies[i]);
+				}
+				const int iterations = n >= 10000 ? 10 : (n >= 1000 ? 40 : 200);
+				for (BroadphaseType bp : { BroadphaseType::Grid, BroadphaseType::SweepAndPrune, BroadphaseType::DynamicTree }) {
+					physics.SetBroadphase(bp);
+					runner.Measure("physics/step",
+						{ { "bodies", n }, { "static_pct", static_pct }, { "shape", ShapeName(shape) }, { "broadphase", BroadphaseName(bp) } },
+						static_cast<size_t>(n), 2, iterations,
+						[&] { for (Bench::BenchBody* b : dynamic_bodies) b->Nudge(); },
+						[&] { physics.Step(); });
+				}
+				physics.SetBroadphase(BroadphaseType::Grid);
+				objs.DestroyAll();
+			}
+		}
+	}
+	physics.SetWorldBounds(saved_bounds);
+}
+
+// 大物体混合场景：large_pct% 的物体边长放大到 6 倍（覆盖多个格子，类似被放大的移动刺与长平台），其余同 physics/step
+void RunStepLarge(Bench::Runner& runner)
+{
+	ObjManager& objs = ObjManager::Instance();
+	PhysicsSystem& physics = PhysicsSystem::Instance();
+	const CF_Aabb saved_bounds = physics.GetWorldBounds();
+
+	for (int n : { 1000, 10000 }) {
+		const CF_Aabb arena = ArenaFor(n);
+		physics.SetWorldBounds(arena);
+		for (int large_pct : { 0, 10 }) {
+			Bench::Rng rng(static_cast<uint32_t>(n * 17 + large_pct));
+			std::vector<Bench::BodyDesc> descs(static_cast<size_t>(n));
+			for (size_t i = 0; i < descs.size(); ++i) {
+				Bench::BodyDesc& d = descs[i];
+				d.pos = cf_v2(rng.Range(arena.min.x, arena.max.x), rng.Range(arena.min.y, arena.max.y));
+				d.half = rng.Range(6.0f, 14.0f);
+				if (static_cast<int>(rng.Next() % 100) < large_pct) d.half *= 6.0f;
+				d.is_static = i % 2 == 0;
+			}
+			std::vector<Bench::BenchBody*> bodies = Bench::SpawnBodies(descs);
+			std::vector<Bench::BenchBody*> dynamic_bodies;
+			for (size_t i = 0; i < bodies.size(); ++i) {
+				if (!descs[i].is_static) dynamic_bodies.push_back(bodies[i]);
+			}
+			for (BroadphaseType bp : { BroadphaseType::Grid, BroadphaseType::SweepAndPrune, BroadphaseType::DynamicTree }) {
+				physics.SetBroadphase(bp);
+				runner.Measure("physics/step_large",
+					{ { "bodies", n }, { "large_pct", large_pct }, { "broadphase", BroadphaseName(bp) } },
+					static_cast<size_t>(n), 2, n >= 10000 ? 10 : 40,
+					[&] { for (Bench::BenchBody* b : dynamic_bodies) b->Nudge(); },
+					[&] { physics.Step(); });
+			}
+			physics.SetBroadphase(BroadphaseType::Grid);
+			objs.DestroyAll();
+		}
+	}
+	physics.SetWorldBounds(saved_bounds);
+}
+
+// 一排静态地面 + n 个每帧被压入地面的动态物体（Projectile 层，彼此不碰撞），测量包含排斥求解的整帧 UpdateAll
+void RunExclusion(Bench::Runner& runner)
+{
+	ObjManager& objs = ObjManager::Instance();
+	PhysicsSystem& physics = PhysicsSystem::Instance();
+	const CF_Aabb saved_bounds = physics.GetWorldBounds();
+
+	struct Variant {
+		const char* name;
+		BaseObject::SolidResolveMode mode;
+	};
+	const Variant variants[] = {
+		{ "bisection", BaseObject::SolidResolveMode::Bisection },
+		{ "analytic", BaseObject::SolidResolveMode::Analytic },
+	};
+
+	for (int n : { 100, 1000 }) {
+		const float width = static_cast<float>(n) * 40.0f;
+		physics.SetWorldBounds(cf_make_aabb(cf_v2(-width * 0.5f - 64.0f, -128.0f), cf_v2(width * 0.5f + 64.0f, 128.0f)));
+		for (const Variant& v : variants) {
+			std::vector<Bench::BodyDesc> descs;
+			const int floor_tiles = static_cast<int>(width / 36.0f) + 2;
+			for (int i = 0; i < floor_tiles; ++i) {
+				Bench::BodyDesc f;
+				f.pos = cf_v2(-width * 0.5f + i * 36.0f, -18.0f);
+				f.half = 18.0f;
+				f.is_static = true;
+				f.layer = CollisionLayer::Terrain;
+				descs.push_back(f);
+			}
+			for (int i = 0; i < n; ++i) {
+				Bench::BodyDesc d;
+				d.pos = cf_v2(-width * 0.5f + 20.0f + i * 40.0f, 8.0f);
+				d.half = 8.0f;
+				d.layer = CollisionLayer::Projectile;
+				d.exclude_solids = true;
+				d.resolve_mode = v.mode;
+				d.push_down = 4.0f;
+				descs.push_back(d);
+			}
+			Bench::SpawnBodies(descs);
+			runner.Measure("physics/exclusion_frame",
+				{ { "bodies", n }, { "resolve", v.name } },
+				static_cast<size_t>(n), 5, 60,
+				[&] { objs.UpdateAll(); });
+			objs.DestroyAll();
+		}
+	}
+	physics.SetWorldBounds(saved_bounds);
+}
+
+// 一排静态地面 + n 个压在地面上的物体（Projectile 层），Step 建立接触对后逐个 Unregister（子弹到期、房间内批量销毁的路径）；
+// 另有 extra_pairs 对互不相关的接触（Default 层物体两两重叠）常驻，用于确认注销耗时与其它接触对的数量无关
+void RunUnregister(Bench::Runner& runner)
+{
+	ObjManager& objs = ObjManager::Instance();
+	PhysicsSystem& physics = PhysicsSystem::Instance();
+	const CF_Aabb saved_bounds = physics.GetWorldBounds();
+
+	for (int n : { 100, 1000 }) {
+		for (int extra_pairs : { 0, 10000 }) {
+			const float width = static_cast<float>(n) * 40.0f;
+			const float height = 64.0f + static_cast<float>(extra_pairs / 100) * 40.0f;
+			physics.SetWorldBounds(cf_make_aabb(cf_v2(-width * 0.5f - 64.0f, -128.0f), cf_v2(width * 0.5f + 64.0f, height + 64.0f)));
+			std::vector<Bench::BodyDesc> descs;
+			const int floor_tiles = static_cast<int>(width / 36.0f) + 2;
+			for (int i = 0; i < floor_tiles; ++i) {
+				Bench::BodyDesc f;
+				f.pos = cf_v2(-width * 0.5f + i * 36.0f, -18.0f);
+				f.half = 18.0f;
+				f.is_static = true;
+				f.layer = CollisionLayer::Terrain;
+				descs.push_back(f);
+			}
+			for (int i = 0; i < n; ++i) {
+				Bench::BodyDesc d;
+				d.pos = cf_v2(-width * 0.5f + 20.0f + i * 40.0f, 6.0f);
+				d.half = 8.0f;
+				d.layer = CollisionLayer::Projectile;
+				descs.push_back(d);
+			}
+			// 重叠的一对：静态 + 动态，形成一个常驻接触对
+			for (int i = 0; i < extra_pairs; ++i) {
+				Bench::BodyDesc d;
+				d.pos = cf_v2(-width * 0.5f + 20.0f + static_cast<float>(i % 100) * 40.0f, 64.0f + static_cast<float>(i / 100) * 40.0f);
+				d.half = 8.0f;
+				d.is_static = true;
+				descs.push_back(d);
+				d.pos.x += 4.0f;
+				d.is_static = false;
+				descs.push_back(d);
+			}
+			std::vector<Bench::BenchBody*> bodies = Bench::SpawnBodies(descs);
+			std::vector<std::pair<ObjManager::ObjToken, Bench::BenchBody*>> projectiles;
+			std::vector<Bench::BenchBody*> dynamic_bodies;
+			for (size_t i = 0; i < bodies.size(); ++i) {
+				if (descs[i].is_static) continue;
+				dynamic_bodies.push_back(bodies[i]);
+				if (descs[i].layer == CollisionLayer::Projectile) projectiles.emplace_back(bodies[i]->Token(), bodies[i]);
+			}
+			runner.Measure("physics/unregister",
+				{ { "bodies", n }, { "extra_pairs", extra_pairs } },
+				static_cast<size_t>(n), 2, 20,
+				[&] {
+					// 重新注册并 Step 一次，让每个物体都带着接触对进入计时段
+					for (auto& [tok, body] : projectiles) physics.Register(tok, body);
+					for (Bench::BenchBody* b : dynamic_bodies) b->Nudge();
+					physics.Step();
+				},
+				[&] { for (auto& [tok, body] : projectiles) physics.Unregister(tok); });
+			objs.DestroyAll();
+		}
+	}
+	physics.SetWorldBounds(saved_bounds);
+}
+
+// 空间查询的回归检查：随机物体（一半静态）+ 地面与墙两块 TileLayer。Grid 模式下 QueryBox/RayCast 线性遍历全部条目，
+// 以它的结果为基准比较 SweepAndPrune 与 DynamicTree 模式；TileLayer 部分另与逐格的包围盒测试比较
+void CheckSpatialQueries(Bench::Runner& runner)
+{
+	const char* name = "physics/query_check";
+	if (!runner.Enabled(name)) return;
+	ObjManager& objs = ObjManager::Instance();
+	PhysicsSystem& physics = PhysicsSystem::Instance();
+	const CF_Aabb saved_bounds = physics.GetWorldBounds();
+	objs.DestroyAll();
+
+	const CF_Aabb arena = ArenaFor(400);
+	physics.SetWorldBounds(cf_make_aabb(arena.min - cf_v2(64.0f, 64.0f), arena.max + cf_v2(128.0f, 64.0f)));
+	Bench::Rng rng(4242u);
+	std::vector<Bench::BodyDesc> descs(400);
+	for (size_t i = 0; i < descs.size(); ++i) {
+		Bench::BodyDesc& d = descs[i];
+		d.pos = cf_v2(rng.Range(arena.min.x, arena.max.x), rng.Range(arena.min.y, arena.max.y));
+		d.shape = static_cast<Bench::BodyShape>(rng.Next() % 4);
+		d.half = rng.Range(6.0f, 14.0f);
+		d.is_static = i % 2 == 0;
+	}
+
+	// 地面：底部一整排 + 随机散布的实体格子；墙：物体区域右侧一整列，射线从物体区域外水平打向它
+	const float tile = 36.0f;
+	const int ground_cols = static_cast<int>((arena.max.x - arena.min.x) / tile);
+	ObjManager::ObjToken ground_tok = objs.Create<TileLayer>(arena.min, ground_cols, 6, tile, std::vector<std::string>{});
+	TileLayer* ground = static_cast<TileLayer*>(&objs[ground_tok]);
+	for (int cx = 0; cx < ground_cols; ++cx) ground->SetTile(cx, 0, 0);
+	for (int k = 0; k < 40; ++k) ground->SetTile(static_cast<int>(rng.Next() % ground_cols), 1 + static_cast<int>(rng.Next() % 5), 0);
+	const float wall_x = arena.max.x + 32.0f;
+	const int wall_rows = static_cast<int>((arena.max.y - arena.min.y) / tile);
+	ObjManager::ObjToken wall_tok = objs.Create<TileLayer>(cf_v2(wall_x, arena.min.y), 1, wall_rows, tile, std::vector<std::string>{});
+	TileLayer* wall = static_cast<TileLayer*>(&objs[wall_tok]);
+	for (int cy = 0; cy < wall_rows; ++cy) wall->SetTile(0, cy, 0);
+	Bench::SpawnBodies(descs);
+	objs.TryGetRegisteration(ground_tok);
+	objs.TryGetRegisteration(wall_tok);
+
+	std::vector<CF_Aabb> boxes;
+	std::vector<std::pair<CF_V2, CF_V2>> rays;
+	for (int k = 0; k < 300; ++k) {
+		const CF_V2 c = cf_v2(rng.Range(arena.min.x, arena.max.x), rng.Range(arena.min.y, arena.max.y));
+		const CF_V2 h = cf_v2(rng.Range(4.0f, 80.0f), rng.Range(4.0f, 80.0f));
+		boxes.push_back(cf_make_aabb(c - h, c + h));
+		const CF_V2 from = cf_v2(rng.Range(arena.min.x, arena.max.x), rng.Range(arena.min.y, arena.max.y));
+		const CF_V2 to = cf_v2(rng.Range(arena.min.x, wall_x + tile), rng.Range(arena.min.y - 32.0f, arena.max.y));
+		rays.emplace_back(from, to);
+	}
+
+	// TileLayer 的逐格参考结果：与 box 重叠的实体格子是否存在 / 线段进入实体格子的最小比例
+	auto tiles_overlap = [](const TileLayer& t, const CF_Aabb& box) {
+		for (int cy = 0; cy < t.Rows(); ++cy) {
+			for (int cx = 0; cx < t.Cols(); ++cx) {
+				if (t.IsSolid(cx, cy) && DynamicAabbTree::Overlaps(t.CellAabb(cx, cy), box)) return true;
+			}
+		}
+		return false;
+	};
+	auto tiles_ray = [](const TileLayer& t, CF_V2 from, CF_V2 to, float* fraction) {
+		bool found = false;
+		for (int cy = 0; cy < t.Rows(); ++cy) {
+			for (int cx = 0; cx < t.Cols(); ++cx) {
+				float f = 0.0f;
+				if (!t.IsSolid(cx, cy) || !DynamicAabbTree::RayHitsAabb(from, to - from, t.CellAabb(cx, cy), 1.0f, &f)) continue;
+				if (!found || f < *fraction) *fraction = f;
+				found = true;
+			}
+		}
+		return found;
+	};
+	auto token_less = [](const ObjManager::ObjToken& a, const ObjManager::ObjToken& b) {
+		return a.index != b.index ? a.index < b.index : a.generation < b.generation;
+	};
+	auto contains = [](const std::vector<ObjManager::ObjToken>& v, const ObjManager::ObjToken& t) {
+		return std::find(v.begin(), v.end(), t) != v.end();
+	};
+
+	for (size_t k = 0; k < rays.size(); ++k) {
+		for (const TileLayer* t : { ground, wall }) {
+			float expected = 1.0f;
+			float got = 1.0f;
+			const bool expected_hit = tiles_ray(*t, rays[k].first, rays[k].second, &expected);
+			const bool hit = t->RayCast(rays[k].first, rays[k].second, &got);
+			runner.Expect(name, hit == expected_hit && (!hit || std::fabs(got - expected) < 1e-4f), "TileLayer::RayCast differs from per-cell scan");
+		}
+	}
+
+	struct RayResult {
+		bool found = false;
+		ObjManager::ObjToken hit;
+		float fraction = 1.0f;
+	};
+	std::vector<std::vector<ObjManager::ObjToken>> ref_boxes(boxes.size());
+	std::vector<RayResult> ref_rays(rays.size());
+	for (BroadphaseType bp : { BroadphaseType::Grid, BroadphaseType::SweepAndPrune, BroadphaseType::DynamicTree }) {
+		physics.SetBroadphase(bp);
+		physics.Step();
+		const std::string mode = BroadphaseName(bp);
+		for (size_t k = 0; k < boxes.size(); ++k) {
+			std::vector<ObjManager::ObjToken> out;
+			physics.QueryBox(boxes[k], out);
+			std::sort(out.begin(), out.end(), token_less);
+			if (bp == BroadphaseType::Grid) {
+				runner.Expect(name, contains(out, ground_tok) == tiles_overlap(*ground, boxes[k]), "QueryBox ground tile layer mismatch");
+				runner.Expect(name, contains(out, wall_tok) == tiles_overlap(*wall, boxes[k]), "QueryBox wall tile layer mismatch");
+				ref_boxes[k] = std::move(out);
+			}
+			else {
+				runner.Expect(name, out == ref_boxes[k], "QueryBox (" + mode + ") differs from linear scan");
+			}
+		}
+		for (size_t k = 0; k < rays.size(); ++k) {
+			RayResult r;
+			r.found = physics.RayCast(rays[k].first, rays[k].second, &r.hit, &r.fraction);
+			if (bp == BroadphaseType::Grid) {
+				ref_rays[k] = r;
+				continue;
+			}
+			const RayResult& ref = ref_rays[k];
+			const bool same = r.found == ref.found && (!r.found || (r.hit == ref.hit && std::fabs(r.fraction - ref.fraction) < 1e-4f));
+			runner.Expect(name, same, "RayCast (" + mode + ") differs from linear scan");
+		}
+
+		// 水平打向墙的射线：起点在物体区域之外，途中没有物体，必须命中墙且比例与墙的位置一致
+		for (int k = 0; k < 8; ++k) {
+			const float y = arena.min.y + (k + 0.5f) * (arena.max.y - arena.min.y) / 8.0f;
+			const CF_V2 from = cf_v2(arena.max.x + 16.0f, y);
+			const CF_V2 to = cf_v2(wall_x + 64.0f, y);
+			ObjManager::ObjToken hit;
+			float fraction = 1.0f;
+			const bool found = physics.RayCast(from, to, &hit, &fraction);
+			const float expected = (wall_x - from.x) / (to.x - from.x);
+			runner.Expect(name, found && hit == wall_tok && std::fabs(fraction - expected) < 1e-4f, "RayCast (" + mode + ") passed through tile wall");
+		}
+	}
+
+	physics.SetBroadphase(BroadphaseType::Grid);
+	objs.DestroyAll();
+	physics.SetWorldBounds(saved_bounds);
+}
+
+void RunPhysics(Bench::Runner& runner)
+{
+	CheckSpatialQueries(runner);
+	RunStep(runner);
+	RunStepLarge(runner);
+	RunExclusion(runner);
+	RunUnregister(runner);
+}
+
+}
+
+BENCH_GROUP("physics", RunPhysics);
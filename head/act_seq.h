@@ -8,6 +8,9 @@
 
 class BaseObject; // 前向声明，避免头文件循环引用
 
+// 标记对象状态已偏离房间快照（定义在 base_object.cpp，等价于 obj->MarkStateDiverged()）
+void MarkObjectStateDiverged(BaseObject* obj) noexcept;
+
 /// <summary>
 /// ActSeq - 一个轻量的动作链（帧为单位）执行器。
 ///
@@ -63,6 +66,8 @@ public:
             if (steps_.empty() || obj == nullptr) return false;
             is_playing_ = true;
         }
+        // 动作链的进度无法原地回滚：播放过的对象在重生时重新创建
+        MarkObjectStateDiverged(obj);
 
         {
             std::lock_guard<std::mutex> lg(mutex_);
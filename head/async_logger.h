@@ -0,0 +1,184 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <type_traits>
+
+/*
+ * AsyncLogger — OUTPUT 宏背后的异步日志器。
+ *
+ * 说明：
+ * - 游戏线程只做两件事：把时间戳、头部与参数的原始值编码进一条定长 Record，再把它放进无锁 MPSC 环形队列；
+ *   格式化（时间戳、数值转文本）、写文件与写 std::cerr 全部在后台写线程中完成。
+ * - 参数按类型编码：整数/浮点/bool/char/指针保存原值，字符串拷贝内容；其它可输出类型在提交时就地格式化为字符串。
+ *   单条记录的参数区为 kPayloadBytes 字节，超出部分截断并以 "..." 标记。
+ * - 写线程每次取出一批记录，拼成一个缓冲后一次写入日志文件与 std::cerr，并且每批只 flush 一次。
+ * - 丢弃策略：队列满时直接丢弃新记录并计数（绝不阻塞游戏线程），写线程随后输出一行丢弃数量提示。
+ * - 进程退出时（静态析构）写线程会先把队列写空再退出；之后到达的日志改为同步写 std::cerr。
+ */
+class AsyncLogger {
+public:
+    static constexpr size_t kQueueCapacity = 8192; // 必须为 2 的幂
+    static constexpr size_t kPayloadBytes = 224;
+    static constexpr size_t kHeaderBytes = 32;
+
+    enum class ArgTag : uint8_t { I64, U64, F64, Bool, Char, Str, Ptr };
+
+    struct Record {
+        int64_t wall_ns = 0;          // system_clock 纪元以来的纳秒数
+        char header[kHeaderBytes]{};  // 头部（拷贝，超长截断）
+        uint16_t size = 0;            // payload 已用字节
+        uint8_t argc = 0;
+        bool truncated = false;
+        unsigned char payload[kPayloadBytes];
+    };
+
+    // 在游戏线程上把参数编码进 Record
+    class RecordBuilder {
+    public:
+        explicit RecordBuilder(const char* header) noexcept
+        {
+            m_rec.wall_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::system_clock::now().time_since_epoch()).count();
+            if (header) {
+                const size_t n = std::min(std::strlen(header), kHeaderBytes - 1);
+                std::memcpy(m_rec.header, header, n);
+                m_rec.header[n] = '\0';
+            }
+        }
+
+        template <typename T>
+        void Add(const T& v)
+        {
+            using D = std::decay_t<T>;
+            if constexpr (std::is_same_v<D, bool>) {
+                PutScalar(ArgTag::Bool, static_cast<uint8_t>(v ? 1 : 0));
+            }
+            else if constexpr (std::is_same_v<D, char>) {
+                PutScalar(ArgTag::Char, v);
+            }
+            else if constexpr (std::is_array_v<T> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<T>>, char>) {
+                PutString(std::string_view(v));
+            }
+            else if constexpr (std::is_same_v<D, const char*> || std::is_same_v<D, char*>) {
+                PutString(v ? std::string_view(v) : std::string_view("(null)"));
+            }
+            else if constexpr (std::is_same_v<D, std::string> || std::is_same_v<D, std::string_view>) {
+                PutString(std::string_view(v));
+            }
+            else if constexpr (std::is_enum_v<D>) {
+                PutScalar(ArgTag::I64, static_cast<int64_t>(v));
+            }
+            else if constexpr (std::is_integral_v<D> && std::is_signed_v<D>) {
+                PutScalar(ArgTag::I64, static_cast<int64_t>(v));
+            }
+            else if constexpr (std::is_integral_v<D>) {
+                PutScalar(ArgTag::U64, static_cast<uint64_t>(v));
+            }
+            else if constexpr (std::is_floating_point_v<D>) {
+                PutScalar(ArgTag::F64, static_cast<double>(v));
+            }
+            else if constexpr (std::is_pointer_v<D>) {
+                PutScalar(ArgTag::Ptr, reinterpret_cast<uintptr_t>(v));
+            }
+            else {
+                // 其它类型：无法延迟格式化，就地转成字符串
+                std::ostringstream oss;
+                oss << v;
+                PutString(oss.str());
+            }
+        }
+
+        const Record& Get() const noexcept { return m_rec; }
+
+    private:
+        template <typename S>
+        void PutScalar(ArgTag tag, S value) noexcept
+        {
+            if (!Reserve(1 + sizeof(S))) return;
+            m_rec.payload[m_rec.size++] = static_cast<unsigned char>(tag);
+            std::memcpy(m_rec.payload + m_rec.size, &value, sizeof(S));
+            m_rec.size = static_cast<uint16_t>(m_rec.size + sizeof(S));
+            ++m_rec.argc;
+        }
+
+        void PutString(std::string_view s) noexcept
+        {
+            if (!Reserve(1 + sizeof(uint16_t) + 1)) return;
+            const size_t room = kPayloadBytes - m_rec.size - 1 - sizeof(uint16_t);
+            uint16_t n = static_cast<uint16_t>(std::min(s.size(), room));
+            if (n < s.size()) m_rec.truncated = true;
+            m_rec.payload[m_rec.size++] = static_cast<unsigned char>(ArgTag::Str);
+            std::memcpy(m_rec.payload + m_rec.size, &n, sizeof(n));
+            m_rec.size = static_cast<uint16_t>(m_rec.size + sizeof(n));
+            std::memcpy(m_rec.payload + m_rec.size, s.data(), n);
+            m_rec.size = static_cast<uint16_t>(m_rec.size + n);
+            ++m_rec.argc;
+        }
+
+        bool Reserve(size_t bytes) noexcept
+        {
+            if (m_rec.size + bytes <= kPayloadBytes) return true;
+            m_rec.truncated = true;
+            return false;
+        }
+
+        Record m_rec;
+    };
+
+    static AsyncLogger& Instance() noexcept;
+
+    // OUTPUT 的入口：日志器已析构（静态析构阶段）时退回同步写 std::cerr，否则提交到队列
+    static void Post(const Record& rec) noexcept;
+
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+
+    // 提交一条记录；队列已满时丢弃并返回 false
+    bool Submit(const Record& rec) noexcept;
+
+    // 阻塞直到当前已提交的记录全部写出（调试/退出前使用，不在帧内调用）
+    void Flush() noexcept;
+
+    uint64_t GetDroppedCount() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+    // 把一条记录格式化为一行文本（不含换行），写线程与同步回退路径共用
+    static void FormatRecord(const Record& rec, std::string& out);
+
+private:
+    AsyncLogger();
+    ~AsyncLogger();
+
+    struct Cell {
+        std::atomic<size_t> seq{ 0 };
+        Record rec;
+    };
+
+    bool TryPop(Record& out) noexcept;
+    void WriterLoop();
+    void WriteBatch(const std::string& batch);
+
+    std::unique_ptr<Cell[]> m_cells;
+    alignas(64) std::atomic<size_t> m_enqueue_pos{ 0 };
+    alignas(64) size_t m_dequeue_pos = 0; // 仅写线程访问
+    std::atomic<uint64_t> m_dropped{ 0 };
+    uint64_t m_dropped_reported = 0;
+
+    std::atomic<bool> m_stop{ false };
+    std::atomic<uint64_t> m_written{ 0 };   // 写线程已处理的记录数（Flush 使用）
+    std::atomic<uint64_t> m_submitted{ 0 };
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake;
+    std::thread m_writer;
+};
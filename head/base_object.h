@@ -58,6 +58,7 @@ namespace {
 
 class BaseObject;
 void RenderBaseObjectCollisionDebug(const BaseObject* obj) noexcept;
+void RenderShapeOutlineDebug(const CF_ShapeWrapper& s) noexcept;
 void ManifoldDrawDebug(const CF_Manifold& m) noexcept;
 
 
@@ -156,7 +157,8 @@ public:
     bool IsVisible() const noexcept { return m_visible; }
 
     // 深度控制（渲染顺序），数值越大/小的语义由渲染器决定
-    void SetDepth(int d) noexcept { m_depth = d; }
+    // SetDepth 会通知 DrawingSequence 调整绘制列表中的位置（深度未变化时为空操作）
+    void SetDepth(int d) noexcept;
     int GetDepth() const noexcept { return m_depth; }
 
     // 旋转与旋转策略：
@@ -252,6 +254,19 @@ public:
     // 新增：设置精灵更新频率（向后兼容）
     void SpriteSetUpdateFreq(int update_freq) noexcept;
 
+    /*
+     * 动画片段（clip）：
+     * - AddAnimClip 在 Start 中一次性登记片段（路径 + 竖排帧数 + 更新频率），图像通过 SpriteCache 预加载并持有引用，返回片段 id；
+     * - PlayAnimClip 只替换当前精灵的图像 id、尺寸与帧参数，不做任何文件读取，也不重新注册绘制序列；
+     *   片段不变时调用为空操作（restart 为 true 时从第 0 帧重播），因此可以在 EndFrame 中每帧调用；
+     * - 调用 SpriteSetSource 会退出片段模式。
+     */
+    int AddAnimClip(const std::string& name, const std::string& path, int vertical_frame_count, int update_freq) noexcept;
+    int FindAnimClip(const std::string& name) const noexcept;
+    void PlayAnimClip(int clip_id, bool restart = false) noexcept;
+    void PlayAnimClip(const std::string& name, bool restart = false) noexcept { PlayAnimClip(FindAnimClip(name), restart); }
+    int GetCurrentAnimClip() const noexcept { return m_anim_clip; }
+
     // 碰撞体旋转/应用 pivot 的策略开关：
     // - IsColliderRotate(true/false)：若为 true，同步 sprite 的旋转到物理碰撞体（常用于角色随朝向旋转时碰撞体也跟随）
     // - IsColliderApplyPivot(true/false)：若为 true，pivot 改变会影响碰撞体的局部位置
@@ -296,6 +311,18 @@ public:
     // 碰撞类型设置（影响如何参与碰撞分组/判定）
     void SetColliderType(ColliderType t) noexcept { set_collider_type(t); }
 
+    // 碰撞层：决定与哪些对象进行碰撞检测（层之间的关系由 PhysicsSystem 的层矩阵决定）
+    // - SetCollisionMask 可在层矩阵基础上进一步排除某些层（参数为 collision_layer_bit 的组合）
+    void SetCollisionLayer(CollisionLayer l) noexcept { set_collision_layer(l); }
+    CollisionLayer GetCollisionLayer() const noexcept { return get_collision_layer(); }
+    void SetCollisionMask(uint32_t m) noexcept { set_collision_mask(m); }
+    uint32_t GetCollisionMask() const noexcept { return get_collision_mask(); }
+
+    // 静态标记：不会移动的地形/陷阱应在 Start() 中调用 SetStatic(true)，
+    // 物理系统会把它放入持久的静态网格，不再每帧重建，也不测试 静态-静态 对。
+    void SetStatic(bool s) noexcept { set_static(s); }
+    bool IsStatic() const noexcept { return is_static(); }
+
     /*
      * SetCentered*
      * 推荐使用的碰撞体构造器：在对象局部坐标系以中心为原点创建形状。
@@ -375,7 +402,16 @@ public:
 	void ExcludeWithSolids(bool v) noexcept { m_exclude_with_solid = v; }
 	bool IsExcludeWithSolids() const noexcept { return m_exclude_with_solid; }
 
+	// 排斥固体的求解方式（按对象选择）：
+	// - Bisection：沿速度分 16 段回退并二分逼近接触位置（默认，narrowphase 调用次数多）
+	// - Analytic：AABB-AABB 使用扫掠 AABB 解析求出推出量，其它形状使用保守推进（cf_toi）求接触时刻，
+	//   每次接触只需两三次 narrowphase；两种方式都会停在保留微小重叠的"刚好接触"位置，OnExclusionSolid 收到的法线一致
+	enum class SolidResolveMode : uint8_t { Bisection, Analytic };
+	void SetSolidResolveMode(SolidResolveMode mode) noexcept { m_solid_resolve_mode = mode; }
+	SolidResolveMode GetSolidResolveMode() const noexcept { return m_solid_resolve_mode; }
+
 	// 碰撞检测：直接比较两个对象当前的 shape，若重叠即填充 out_m 并返回 true
+	// （other 为 TileLayer 时按格子检测，返回穿透最深的格子的 manifold）
 	bool IsCollidedWith(const BaseObject& other, CF_Manifold& out_m) noexcept;
 
 
@@ -423,6 +459,11 @@ public:
     // 对象销毁钩子：在对象被销毁前由管理器调用，派生类可重载以释放资源
     virtual void OnDestroy() noexcept {}
 
+    // 房间快照：派生类的私有状态（触发标志、计数器等）发生变化时调用，重生时该对象会按配方重新创建，
+    // 而不是原地保留。ActSeq::play 会自动调用；位置/速度/精灵等基础状态的变化无需上报。
+    void MarkStateDiverged() noexcept { m_state_diverged = true; }
+    bool IsStateDiverged() const noexcept { return m_state_diverged; }
+
     ~BaseObject() noexcept;
 
     // 新增：获取底层 CF_Sprite 的 const 引用
@@ -437,6 +478,7 @@ protected:
 private:
     friend class ObjManager;
     friend class DrawingSequence;
+    friend struct RoomSnapshot;
 
     // 说明：将 BasePhysics 的常用方法在 BaseObject 中设为私有，阻止派生类未限定名调用。
     // 目的：
@@ -474,6 +516,12 @@ private:
     using BasePhysics::force_update_world_shape;
     using BasePhysics::world_shape_version;
     using BasePhysics::mark_world_shape_dirty;
+    using BasePhysics::set_static;
+    using BasePhysics::set_collision_layer;
+    using BasePhysics::get_collision_layer;
+    using BasePhysics::set_collision_mask;
+    using BasePhysics::get_collision_mask;
+    using BasePhysics::is_static;
 
 	// 内部工具：根据 pivot 微调碰撞体；实现细节在 cpp 文件中（供 SetPivot 调用）
 	void TweakColliderWithPivot(const CF_V2& pivot) noexcept;
@@ -481,6 +529,9 @@ private:
     CF_Sprite m_sprite{}; // 使用框架的 CF_Sprite
     bool m_visible = true;
     int m_depth = 0;
+    // DrawingSequence 中的槽位下标（未注册时为 kNoDrawSlot），由 DrawingSequence 维护
+    static constexpr uint32_t kNoDrawSlot = 0xFFFFFFFFu;
+    uint32_t m_draw_slot = kNoDrawSlot;
     // 新增：用于支持 SpriteSetUpdateFreq
     std::string m_sprite_path;
     int m_sprite_vertical_frame_count = 1;
@@ -488,6 +539,17 @@ private:
 	int m_sprite_update_freq = 1; // 每多少帧递增帧索引
     int m_sprite_last_update_frame = 0; // 上一次实际切换帧的全局帧计数
 
+    // 动画片段：图像在 AddAnimClip 时从 SpriteCache 取得，析构时归还
+    struct AnimClip {
+        std::string name;
+        std::string path;
+        CF_Sprite sprite{};
+        int vertical_frame_count = 1;
+        int update_freq = 1;
+    };
+    std::vector<AnimClip> m_anim_clips;
+    int m_anim_clip = -1; // 当前播放的片段，-1 表示使用 SpriteSetSource 设置的单一精灵
+
     CF_V2 m_prev_position = CF_V2{ 0.0f, 0.0f };
 	CF_V2 m_pivot = CF_V2{ 0.0f, 0.0f };
 
@@ -498,11 +560,25 @@ private:
      CF_Manifold ExclusionWithSolid(const ObjManager::ObjToken& oth, const CF_Manifold& m) noexcept;
 	// 二分查找接触点位置，在排斥过程中用于逼近刚好接触的坐标
      void FindContactPos(CF_V2 current, CF_V2 offset, const BaseObject& other, CF_Manifold& res);
+	// 解析版排斥（SolidResolveMode::Analytic）
+     CF_Manifold ExclusionWithSolidAnalytic(const BaseObject& other) noexcept;
+	// 解析排斥的核心：把自身从单个 world-space 形状 B 中推出，返回推出后与 B 的 manifold
+     CF_Manifold ResolveSolidShapeAnalytic(const CF_ShapeWrapper& B) noexcept;
+	// 与 TileLayer 排斥：按重叠面积从大到小逐格解析求解，每个被求解的格子都会回调 OnExclusionSolid
+     CF_Manifold ExclusionWithTiles(const ObjManager::ObjToken& oth, const TileLayer& tiles) noexcept;
+	// 与单个 world-space 形状做 narrowphase
+     bool CollideWithShape(const CF_ShapeWrapper& B, CF_Manifold& out_m) const noexcept;
+	SolidResolveMode m_solid_resolve_mode = SolidResolveMode::Bisection;
+	// 解析排斥后保留的重叠量（像素），保证下一帧仍能检测到接触并产生 Stay 事件
+	static constexpr float kSolidContactSkin = 0.01f;
  	// 每帧累积的碰撞信息（仅用于调试/后续逻辑），在 FrameEnterApply 开头清空
      std::vector<CF_Manifold> m_collide_manifolds;
 
 	std::unordered_set<std::string> tags;
 
+    // 一经置位不再清除：对象被重新创建时随新对象一起复位
+    bool m_state_diverged = false;
+
     ObjManager::ObjToken m_obj_token = ObjManager::ObjToken::Invalid();
 
     void SetObjToken(const ObjManager::ObjToken& t) noexcept { m_obj_token = t; }
@@ -3,10 +3,24 @@
 #include <vector>
 #include <unordered_map>
 #include <cstdint>
+#include <cmath>
 
 #include "obj_manager.h"
+#include "dynamic_aabb_tree.h"
 #include "v2math.h"
 
+// broadphase 的 SSE2 批量包围盒筛选：x64 与开启 SSE2 的 x86 默认启用，其它平台（或定义为 0 时）使用等价的标量循环
+#ifndef MCG_PHYSICS_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MCG_PHYSICS_SSE2 1
+#else
+#define MCG_PHYSICS_SSE2 0
+#endif
+#endif
+#if MCG_PHYSICS_SSE2
+#include <emmintrin.h>
+#endif
+
 // CF_ShapeWrapper 封装了不同类型的碰撞形状（AABB, Circle, Capsule, Poly），
 // 并提供静态工厂函数便于创建对应的包装类型。
 	// 目的：
@@ -36,8 +50,41 @@ enum class ColliderType {
 	SOLID // 实体碰撞（常规碰撞：阻挡、反弹等）
 };
 
+// 碰撞层：每个物体属于一个层，PhysicsSystem 的层矩阵决定哪些层之间需要进行碰撞检测
+// - 被矩阵（或物体自身的 collision mask）过滤的对不会进入 narrowphase，也不会产生事件
+// - 未设置层的物体属于 Default，与所有层碰撞（保持旧行为）
+enum class CollisionLayer : uint8_t {
+	Default = 0, // 未分类对象，与所有层碰撞
+	Player,      // 玩家
+	Terrain,     // 地形方块（含移动方块）
+	Hazard,      // 刺、樱桃等陷阱
+	Projectile,  // 子弹
+	Effect,      // 血液等表现用粒子，只与地形碰撞
+	Trigger,     // 存档点等触发器
+	Count
+};
+
+// 层对应的位标志，用于 collision mask
+constexpr uint32_t collision_layer_bit(CollisionLayer l) noexcept { return 1u << static_cast<uint8_t>(l); }
+constexpr uint32_t kCollisionMaskAll = 0xFFFFFFFFu;
+
+// broadphase 算法：由房间选择（BaseRoom::Broadphase），产生的碰撞结果相同，只是适用的对象分布不同
+enum class BroadphaseType : uint8_t {
+	Grid,          // 均匀网格：对象尺寸接近格子、分布均匀时最快
+	SweepAndPrune, // X 轴排序扫描：对象远大于格子（放大的移动刺、背景、长平台）或大量对象挤在同一格子时更稳定
+	DynamicTree    // 动态包围盒树（胖包围盒）：大量缓慢移动的陷阱在胖包围盒内移动时不更新树，尺寸差异大时也不退化
+};
+
 // 前置声明：BasePhysics 提供给上层对象一个统一的物理属性/形状接口
 class BasePhysics;
+class TileLayer;
+
+// 计算 world-space 形状的轴对齐包围盒（broadphase 与 TileLayer 的格子查询共用）
+CF_Aabb shape_wrapper_to_aabb(const CF_ShapeWrapper& s) noexcept;
+
+// AABB 与 AABB 的 manifold（法线由 a 指向 b，结果与 cf_collide 一致但不经过通用的形状分发）；
+// narrowphase 分发表与 TileLayer 的格子测试共用
+bool aabb_to_aabb_manifold(const CF_Aabb& a, const CF_Aabb& b, CF_Manifold* out) noexcept;
 
 // PhysicsSystem 提供面向使用者的物理子系统入口：
 // - 注册/反注册 BasePhysics 实例（通过 ObjToken 关联对象生命周期）
@@ -51,6 +98,10 @@ public:
 		CF_Manifold manifold{};
 		float distance_a = 0.0f;
 		float distance_b = 0.0f;
+		bool oriented = false; // manifold 法线已确定为 a 指向 b（TileLayer 事件），分发时不再按位置重新定向
+		// Step 内部使用：pair key（见 make_pair_key）与上一帧是否已接触
+		uint64_t pair_key = 0;
+		bool stay = false;
 	};
 
 	static PhysicsSystem& Instance() noexcept
@@ -62,17 +113,58 @@ public:
 	// 将 BasePhysics 实例加入物理系统以参与碰撞检测（通常在对象 Start() 时调用）
 	// - token 必须由 ObjManager 发放且在对象实际合并到管理器后才应该被注册
 	// - phys 指针由 ObjManager 管理的对象提供（不要传入栈对象指针）
+	// - TileLayer 不进入网格，而是单独保存；Step 中每个动态条目直接按格子查询图层
 	void Register(const ObjManager::ObjToken& token, BasePhysics* phys) noexcept;
 
 	// 从系统中移除指定 token 的物理条目（通常在对象销毁前调用）
+	// - 只移除该物体自己的接触对（经 body_pairs_ 定位），与其它碰撞对数量无关
+	// - 被移除的接触对不再产生 Exit：销毁的物体与其接触对象都不会收到 Exit 回调
 	void Unregister(const ObjManager::ObjToken& token) noexcept;
 
-	// 每帧推进物理系统（cell_size 可调整 broadphase 网格规模，默认 64.0f）
-	// - Step 包含 broadphase 网格划分、narrowphase 碰撞测试、合并多个 contact 为单对事件、以及生成 Enter/Stay/Exit 回调
+	// 一次性清空全部条目与碰撞对记录（ObjManager::DestroyAll 使用，代替逐个 Unregister）
+	void UnregisterAll() noexcept;
+	// 批量提交前为动态/静态条目表预留容量（ObjManager 提交 pending 创建时调用）
+	void Reserve(size_t dynamic_count, size_t static_count);
+
+	// 每帧推进物理系统（cell_size 可调整 broadphase 网格规模，默认 64.0f；只有 Grid 使用）
+	// - Step 包含 broadphase（网格、X 轴排序扫描或动态包围盒树，见 SetBroadphase）、narrowphase 碰撞测试、合并多个 contact 为单对事件、以及生成 Enter/Stay/Exit 回调
+	// - 静态层（static tier）的网格仅在静态集合变化时重建；每帧只重建动态网格，且只测试 动态-动态 / 动态-静态 对
 	void Step(float cell_size = 64.0f) noexcept;
 
+	// 选择 broadphase（切换后下一次 Step 生效；网格、排序列表与树在切换时重建）
+	void SetBroadphase(BroadphaseType type) noexcept;
+	BroadphaseType GetBroadphase() const noexcept { return broadphase_; }
+
+	// 设置 broadphase 稠密网格覆盖的世界范围（默认与 1152x864 窗口一致，原点位于窗口中心）
+	// - 范围内的格子使用连续数组存储，范围外的对象退回哈希桶，因此该范围只影响性能而不影响正确性
+	void SetWorldBounds(const CF_Aabb& bounds) noexcept;
+	const CF_Aabb& GetWorldBounds() const noexcept { return world_bounds_; }
+
+	// 碰撞层矩阵：设置两层之间是否进行碰撞检测（对称）
+	void SetLayerCollision(CollisionLayer a, CollisionLayer b, bool enable) noexcept;
+	bool ShouldLayersCollide(CollisionLayer a, CollisionLayer b) const noexcept
+	{
+		return (layer_matrix_[static_cast<uint8_t>(a)] & collision_layer_bit(b)) != 0;
+	}
+	// 恢复默认矩阵（玩家/地形/陷阱/子弹/粒子/触发器之间的默认关系，见 Collider.cpp）
+	void ResetLayerMatrix() noexcept;
+
+	// 空间查询：DynamicTree 模式经树筛选候选，其它模式线性遍历全部条目；候选都以当前的 world 形状精确检查。
+	// TileLayer 在任何模式下都按格子直接查询（box 覆盖的实体格子 / 射线逐格步进），命中时返回整个 TileLayer 的 token。
+	// DynamicTree 模式下条目在 Register 时即建立代理，新注册的条目立即可查；代理的胖包围盒在 Step 时刷新，
+	// 因此上一次 Step 之后移动超过 kTreeFatMargin（离开胖包围盒）的条目要到下一次 Step 才能按新位置查到
+	// - QueryBox：把 world 包围盒与 box 重叠（含相切）的条目 token 追加到 out
+	// - RayCast：线段 from -> to 命中的最近条目；fraction 为命中点在线段上的比例（0..1），未命中返回 false
+	void QueryBox(const CF_Aabb& box, std::vector<ObjManager::ObjToken>& out) const;
+	bool RayCast(const CF_V2& from, const CF_V2& to, ObjManager::ObjToken* hit, float* fraction = nullptr) const;
+
+	// 调试/统计：当前静态层、动态层与 TileLayer 的条目数
+	size_t GetStaticCount() const noexcept { return static_entries_.size(); }
+	size_t GetDynamicCount() const noexcept { return dynamic_entries_.size(); }
+	size_t GetTileLayerCount() const noexcept { return tile_layers_.size(); }
+
 private:
-	PhysicsSystem() noexcept = default;
+	PhysicsSystem() noexcept { ResetLayerMatrix(); }
 	~PhysicsSystem() noexcept = default;
 
 	struct Entry {
@@ -81,41 +173,229 @@ private:
 		int32_t grid_x = 0;
 		int32_t grid_y = 0;
 		bool dirty = true;
+		uint64_t shape_version = 0; // 上次入网格时的 world_shape_version，用于检测静态条目是否被移动
+		uint32_t rest_frames = 0;   // 连续静止帧数（用于自动升级为静态）
+		bool auto_static = false;   // 是否由系统自动升级为静态（未显式 set_static）
+		uint32_t sap_proxy = 0xFFFFFFFFu; // 上一帧在 sap_proxies_ 中的位置（SweepAndPrune 使用，随条目一起迁移，用 key 校验）
+		int32_t tree_proxy = DynamicAabbTree::kNull; // 在 tree_ 中的代理 id（DynamicTree 使用，以代理的 user data 即 make_key 校验）
 	};
 
+	// 一个接触对：first 为 index 较小的一方；alive 为 false 表示其中一方已注销（Step 归并时跳过，不产生 Exit）
+	struct ContactPair {
+		uint64_t key = 0;
+		ObjManager::ObjToken first;
+		ObjManager::ObjToken second;
+		bool alive = true;
+	};
+
+	// 接触对与物体接触列表的增删（Step 中 Enter 时 link，Exit 时 unlink）
+	void link_pair(const ContactPair& cp);
+	void unlink_pair(const ContactPair& cp) noexcept;
+
+	// 层矩阵与双方 collision mask 均允许时才进行 narrowphase
+	bool layers_allow(const BasePhysics* a, const BasePhysics* b) const noexcept;
+
+	// SweepAndPrune 的代理：按 min_x 排序并跨帧保留顺序，每帧只需对几乎有序的数组做插入排序
+	struct SapProxy {
+		uint64_t key = 0;  // 条目的 make_key，用于校验 Entry::sap_proxy
+		uint32_t ref = 0;  // kStaticRefBit | 条目在所属层中的下标；kSapStale 表示本帧没有条目认领（已注销）
+		float min_x = 0.0f, max_x = 0.0f, min_y = 0.0f, max_y = 0.0f;
+	};
+	// SapProxy::ref 与 tree_refs_ 共用的条目引用编码：最高位表示静态层，其余位为层内下标
+	static constexpr uint32_t kStaticRefBit = 0x80000000u;
+	static constexpr uint32_t kSapStale = 0xFFFFFFFFu;
+
+	// 同步代理与条目（新增/注销/迁移层），刷新包围盒后按 min_x 插入排序
+	void update_sap() noexcept;
+
+	// DynamicTree：动态条目的胖包围盒在紧包围盒四周各扩展的距离（世界单位）；静态条目不扩展
+	static constexpr float kTreeFatMargin = 8.0f;
+	// 为新条目创建代理、移动离开胖包围盒的代理，并回写 tree_refs_
+	void update_tree() noexcept;
+	// 条目是否持有自己的树代理（条目在层间迁移或切换 broadphase 后，tree_proxy 可能已失效或被复用）
+	bool owns_tree_proxy(const Entry& e) const noexcept
+	{
+		return tree_.IsProxy(e.tree_proxy) && tree_.GetUserData(e.tree_proxy) == make_key(e.token);
+	}
+	void release_tree_proxy(Entry& e) noexcept;
+	// 按 make_key 在动态/静态层中查找条目（空间查询使用）
+	const Entry* find_entry(uint64_t key) const noexcept;
+
+	// 连续静止多少帧后，SOLID/VOID 条目会被自动移入静态层
+	static constexpr uint32_t kAutoStaticRestFrames = 30;
+
+	// 在动态层与静态层之间迁移条目（swap-remove 并维护 token 映射）
+	void move_to_static(size_t dynamic_idx) noexcept;
+	void move_to_dynamic(size_t static_idx) noexcept;
+
 	// 将 (index,generation) 编码为 uint64_t，以便与 ObjManager 的 token 匹配
 	static uint64_t make_key(const ObjManager::ObjToken& t) noexcept
 	{
 		return (static_cast<uint64_t>(t.index) << 32) | static_cast<uint64_t>(t.generation);
 	}
 
+	// 碰撞对的键：(较小 index << 32) | 较大 index，与 a/b 的顺序无关且不会冲突。
+	// 只用 index 即可区分：物体注销时它的接触对随之失效，槽位复用后的新对象不会继承旧的对
+	static uint64_t make_pair_key(const ObjManager::ObjToken& a, const ObjManager::ObjToken& b) noexcept
+	{
+		const uint32_t lo = a.index < b.index ? a.index : b.index;
+		const uint32_t hi = a.index < b.index ? b.index : a.index;
+		return (static_cast<uint64_t>(lo) << 32) | static_cast<uint64_t>(hi);
+	}
+	static constexpr uint64_t kNoPairKey = ~0ull;
+	static ContactPair make_contact_pair(uint64_t key, const ObjManager::ObjToken& a, const ObjManager::ObjToken& b) noexcept
+	{
+		ContactPair cp;
+		cp.key = key;
+		cp.first = a.index < b.index ? a : b;
+		cp.second = a.index < b.index ? b : a;
+		return cp;
+	}
+
 	// 将 grid 坐标编码为 uint64_t 用作 unordered_map 的键
 	static uint64_t grid_key(int32_t x, int32_t y) noexcept
 	{
 		return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint64_t>(static_cast<uint32_t>(y));
 	}
 
+	// 有界稠密网格：
+	// - 世界范围内的格子通过计数排序构建（每格计数 -> 前缀和 -> 一个连续的索引数组），查询无需哈希
+	// - 超出范围的格子退回 overflow 哈希桶（仅用于越界对象）
+	// - 所有容器在帧间复用，稳定运行时不产生分配
+	struct CellGrid {
+		struct CellRange { int32_t x0, y0, x1, y1; };
+
+		float cell_size = 0.0f;
+		int32_t origin_x = 0; // 稠密区域左下角的格坐标
+		int32_t origin_y = 0;
+		int32_t cols = 0;
+		int32_t rows = 0;
+		std::vector<uint32_t> cell_start; // 大小 cols*rows+1，第 c 格的条目位于 [cell_start[c], cell_start[c+1])
+		std::vector<uint32_t> cell_items; // 按格子连续存放的条目索引
+		std::vector<uint32_t> cursor;     // 构建时的写游标
+		std::vector<CellRange> ranges;    // 每个条目覆盖的格子范围（两趟构建之间复用）
+		std::unordered_map<uint64_t, std::vector<uint32_t>> overflow;
+		std::vector<uint64_t> overflow_keys_used;
+		// 与 cell_items 一一对应的 SoA 包围盒，供 for_each_overlap_in_cell 以 SIMD 批量比较
+		std::vector<float> item_min_x, item_min_y, item_max_x, item_max_y;
+		const std::vector<CF_Aabb>* source = nullptr; // 上次 build 的输入（越界 bucket 的标量比较使用）
+
+		// 根据世界范围与格子尺寸确定稠密区域
+		void configure(const CF_Aabb& bounds, float cell) noexcept;
+		// 以 aabbs[i] 覆盖的格子重建网格（条目索引即 i）
+		void build(const std::vector<CF_Aabb>& aabbs) noexcept;
+
+		int32_t cell_coord(float v) const noexcept { return static_cast<int32_t>(std::floor(v / cell_size)); }
+
+		// 遍历格子 (gx, gy) 中的所有条目索引
+		template <typename Fn>
+		void for_each_in_cell(int32_t gx, int32_t gy, Fn&& fn) const noexcept
+		{
+			const int32_t lx = gx - origin_x;
+			const int32_t ly = gy - origin_y;
+			if (lx >= 0 && ly >= 0 && lx < cols && ly < rows) {
+				const size_t c = static_cast<size_t>(ly) * static_cast<size_t>(cols) + static_cast<size_t>(lx);
+				for (uint32_t k = cell_start[c], end = cell_start[c + 1]; k < end; ++k) fn(cell_items[k]);
+				return;
+			}
+			if (overflow.empty()) return;
+			auto it = overflow.find(grid_key(gx, gy));
+			if (it == overflow.end()) return;
+			for (uint32_t j : it->second) fn(j);
+		}
+
+		// 遍历格子 (gx, gy) 中包围盒与 box 重叠（含相切）的条目索引：
+		// 稠密区域内对连续的 SoA 区间每次比较 4 个条目，只有通过筛选的条目才进入 narrowphase
+		template <typename Fn>
+		void for_each_overlap_in_cell(int32_t gx, int32_t gy, const CF_Aabb& box, Fn&& fn) const noexcept
+		{
+			const int32_t lx = gx - origin_x;
+			const int32_t ly = gy - origin_y;
+			if (lx >= 0 && ly >= 0 && lx < cols && ly < rows) {
+				const size_t c = static_cast<size_t>(ly) * static_cast<size_t>(cols) + static_cast<size_t>(lx);
+				uint32_t k = cell_start[c];
+				const uint32_t end = cell_start[c + 1];
+#if MCG_PHYSICS_SSE2
+				const __m128 bmin_x = _mm_set1_ps(box.min.x);
+				const __m128 bmin_y = _mm_set1_ps(box.min.y);
+				const __m128 bmax_x = _mm_set1_ps(box.max.x);
+				const __m128 bmax_y = _mm_set1_ps(box.max.y);
+				for (; k + 4 <= end; k += 4) {
+					const __m128 ox = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&item_min_x[k]), bmax_x),
+						_mm_cmpge_ps(_mm_loadu_ps(&item_max_x[k]), bmin_x));
+					const __m128 oy = _mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(&item_min_y[k]), bmax_y),
+						_mm_cmpge_ps(_mm_loadu_ps(&item_max_y[k]), bmin_y));
+					const int bits = _mm_movemask_ps(_mm_and_ps(ox, oy));
+					if (bits == 0) continue;
+					for (int b = 0; b < 4; ++b) {
+						if (bits & (1 << b)) fn(cell_items[k + b]);
+					}
+				}
+#endif
+				for (; k < end; ++k) {
+					if (item_min_x[k] <= box.max.x && item_max_x[k] >= box.min.x
+						&& item_min_y[k] <= box.max.y && item_max_y[k] >= box.min.y) fn(cell_items[k]);
+				}
+				return;
+			}
+			if (overflow.empty() || !source) return;
+			auto it = overflow.find(grid_key(gx, gy));
+			if (it == overflow.end()) return;
+			for (uint32_t j : it->second) {
+				const CF_Aabb& a = (*source)[j];
+				if (a.min.x <= box.max.x && a.max.x >= box.min.x && a.min.y <= box.max.y && a.max.y >= box.min.y) fn(j);
+			}
+		}
+	};
+
 	std::vector<Entry> dynamic_entries_;
 	std::unordered_map<uint64_t, size_t> dynamic_token_map_;
 
 	std::vector<Entry> static_entries_;
 	std::unordered_map<uint64_t, size_t> static_token_map_;
 
-	std::unordered_map<uint64_t, std::vector<size_t>> grid_; // broadphase 网格映射
+	// 已注册的 TileLayer（数量很少，线性遍历）
+	std::vector<Entry> tile_layers_;
+
+	CellGrid grid_; // broadphase 网格（仅动态条目，每帧重建）
+
+	// 静态层：持久网格，只有在静态条目增删或被移动时才重建
+	CellGrid static_grid_;
+	std::vector<CF_ShapeWrapper> static_world_shapes_;
+	std::vector<CF_Aabb> static_world_aabbs_;
+	bool static_grid_dirty_ = true;
+
+	BroadphaseType broadphase_ = BroadphaseType::Grid;
+	// SweepAndPrune：动态与静态条目共用一个按 min_x 排序的代理数组；扫描时分别维护活跃的动态/静态代理，
+	// 静态代理只与动态代理比较，因此成排的静态物体不会两两比较
+	std::vector<SapProxy> sap_proxies_;
+	std::vector<uint32_t> sap_active_dynamic_;
+	std::vector<uint32_t> sap_active_static_;
+	// DynamicTree：动态与静态条目共用一棵树；以代理 id 索引 tree_refs_ 得到 kStaticRefBit | 条目下标（每帧 update_tree 回写）
+	DynamicAabbTree tree_;
+	std::vector<uint32_t> tree_refs_;
+
+	// 碰撞层矩阵：layer_matrix_[a] 的第 b 位表示 a 与 b 两层是否碰撞
+	uint32_t layer_matrix_[static_cast<size_t>(CollisionLayer::Count)] = {};
+
+	// 稠密网格覆盖的世界范围
+	CF_Aabb world_bounds_{ { -576.0f, -432.0f }, { 576.0f, 432.0f } };
 
 	std::vector<CollisionEvent> events_;
 
-	// 保存上一帧的碰撞对，用于生成 Enter / Exit 事件（pair key -> ordered token pair）
-	std::unordered_map<uint64_t, std::pair<ObjManager::ObjToken, ObjManager::ObjToken>> prev_collision_pairs_;
+	// 上一帧与本帧的碰撞对，均按 pair key 升序排列；Step 以一次线性归并得到 Enter / Stay / Exit，
+	// 三个数组在帧间复用（prev/current 交换），稳定运行时不分配
+	std::vector<ContactPair> prev_pairs_;
+	std::vector<ContactPair> current_pairs_;
+	std::vector<ContactPair> exit_pairs_;
+
+	// 每个物体当前参与的接触对（物体 key -> pair key 列表），与 prev_pairs_ 同步维护；
+	// 列表通常只有几项，物体注销时按它移除自己的接触对，空列表保留到物体注销以免反复分配
+	std::unordered_map<uint64_t, std::vector<uint64_t>> body_pairs_;
 
 	// 每帧使用的 world-shape 缓存与临时容器（避免频繁分配）
 	std::vector<CF_ShapeWrapper> world_shapes_;
-	std::vector<uint64_t> grid_keys_used_; // 记录已分配的 grid 键以便复用容器
-
-	// 合并与临时存储结构（用于合并一对的多个 contact）
-	std::unordered_map<uint64_t, CollisionEvent> merged_map_;
-	std::vector<uint64_t> merged_order_;
-	std::unordered_map<uint64_t, std::pair<ObjManager::ObjToken, ObjManager::ObjToken>> current_pairs_;
+	std::vector<CF_Aabb> world_aabbs_;
 };
 
 // BasePhysics 为可碰撞对象提供通用的物理属性与形状管理接口：
@@ -250,9 +530,26 @@ public:
 	bool is_position_dirty() const noexcept { return position_dirty_; }
 	void clear_position_dirty() noexcept { position_dirty_ = false; }
 
+	// 碰撞层与 mask：layer 决定物体所属层，mask 可进一步排除特定层（默认全部允许）
+	void set_collision_layer(CollisionLayer l) noexcept { collision_layer_ = l; }
+	CollisionLayer get_collision_layer() const noexcept { return collision_layer_; }
+	void set_collision_mask(uint32_t m) noexcept { collision_mask_ = m; }
+	uint32_t get_collision_mask() const noexcept { return collision_mask_; }
+
+	// 静态标记：静态物体在 PhysicsSystem 中进入持久的静态网格，不参与 静态-静态 碰撞测试
+	// - 静态物体仍可以移动（会触发静态网格重建），但频繁移动的物体不应标记为静态
+	void set_static(bool s) noexcept { is_static_ = s; }
+	bool is_static() const noexcept { return is_static_; }
+
+	// 若该物体是 TileLayer 则返回自身，PhysicsSystem 据此改为按格子查询（默认 nullptr）
+	virtual const TileLayer* as_tile_layer() const noexcept { return nullptr; }
+
 	// 访问本地 shape（不触发世界转换）
 	const CF_ShapeWrapper& get_local_shape() const noexcept { return shape; }
 
 private:
 	bool position_dirty_ = true; // 位置脏标记
+	bool is_static_ = false;     // 是否显式标记为静态
+	CollisionLayer collision_layer_ = CollisionLayer::Default;
+	uint32_t collision_mask_ = kCollisionMaskAll;
 };
\ No newline at end of file
@@ -4,9 +4,19 @@
 #define MCG_DEBUG 0
 #endif
 
+// 日志级别上限：0 = Error，1 = Warn，2 = Info，3 = Trace（见下方 LOG_* 宏）
 #ifndef MCG_DEBUG_LEVEL
+#if MCG_DEBUG
+#define MCG_DEBUG_LEVEL 2
+#else
 #define MCG_DEBUG_LEVEL 0
 #endif
+#endif
+
+// 编译期日志类别掩码：按 LogCategory 的顺序取位，未置位的类别在编译期移除
+#ifndef MCG_LOG_CATEGORY_MASK
+#define MCG_LOG_CATEGORY_MASK 0xFFFFFFFFu
+#endif
 
 #if MCG_DEBUG
 #pragma message("debug_config: MCG_DEBUG=1")
@@ -27,21 +37,92 @@
 #ifndef MESSAGE_DEBUG
 #define MESSAGE_DEBUG MCG_DEBUG
 #endif
+// 帧阶段分析器（profiler.h），默认关闭，由 CMake 选项 ENABLE_PROFILE 打开
+#ifndef MCG_PROFILE
+#define MCG_PROFILE 0
+#endif
 #ifndef OUTPUT_DEBUG
 #define OUTPUT_DEBUG MCG_DEBUG
 #endif 
 
 #if OUTPUT_DEBUG
+#include <atomic>
 #include <concepts> // 引入 concepts 头文件
-#include <chrono>
-#include <ctime>
-#include <iomanip>
-#include <iostream>
-#include <sstream>
-#include <string>
-#include <filesystem>
-#include <fstream>
-#include <mutex>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+#include "async_logger.h"
+
+// 日志级别：数值不大于 MCG_DEBUG_LEVEL 的语句才会被编译
+enum class LogLevel : int {
+    Error = 0,
+    Warn = 1,
+    Info = 2,
+    Trace = 3,  // 逐对象/逐帧的高频输出
+};
+
+// 日志类别：每个类别占 MCG_LOG_CATEGORY_MASK 与运行时掩码中的一位（按声明顺序）
+enum class LogCategory : uint32_t {
+    General,          // OUTPUT(...) 与未分类的输出
+    Main,             // 主循环、程序启动/退出
+    ObjManager,
+    Physics,
+    DrawingSequence,
+    Room,             // RoomLoader 与各房间
+    Resource,         // 精灵/贴图/VFS
+    Player,
+    Memory,
+    Count
+};
+
+inline constexpr const char* LogCategoryName(LogCategory c) noexcept
+{
+    constexpr const char* names[] = {
+        "General", "Main", "ObjManager", "Physics", "DrawingSequence", "Room", "Resource", "Player", "Memory"
+    };
+    return c < LogCategory::Count ? names[static_cast<uint32_t>(c)] : "Unknown";
+}
+
+inline constexpr uint32_t LogCategoryBit(LogCategory c) noexcept
+{
+    return 1u << static_cast<uint32_t>(c);
+}
+
+// 编译期判定：级别或类别被过滤的语句整体位于 if constexpr 的舍弃分支中，参数不会被求值
+inline constexpr bool LogCompiledIn(LogLevel level, LogCategory c) noexcept
+{
+    return static_cast<int>(level) <= MCG_DEBUG_LEVEL
+        && (static_cast<uint32_t>(MCG_LOG_CATEGORY_MASK) & LogCategoryBit(c)) != 0;
+}
+
+// 运行时类别掩码（启动参数 --log-categories 设置），默认全部开启
+inline std::atomic<uint32_t>& LogRuntimeMask() noexcept
+{
+    static std::atomic<uint32_t> mask{ 0xFFFFFFFFu };
+    return mask;
+}
+
+inline bool LogRuntimeEnabled(LogCategory c) noexcept
+{
+    return (LogRuntimeMask().load(std::memory_order_relaxed) & LogCategoryBit(c)) != 0;
+}
+
+// 解析逗号分隔的类别名列表（如 "Physics,Room"），"all" 表示全部；无法识别的名字被忽略
+inline uint32_t ParseLogCategoryList(std::string_view list) noexcept
+{
+    uint32_t mask = 0;
+    while (!list.empty()) {
+        const size_t comma = list.find(',');
+        const std::string_view name = list.substr(0, comma);
+        if (name == "all") mask = 0xFFFFFFFFu;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(LogCategory::Count); ++i) {
+            if (name == LogCategoryName(static_cast<LogCategory>(i))) mask |= 1u << i;
+        }
+        if (comma == std::string_view::npos) break;
+        list.remove_prefix(comma + 1);
+    }
+    return mask;
+}
 
 namespace {
     // 1. 定义一个结构体，用于强制使用 'header' 标识符
@@ -56,94 +137,13 @@ namespace {
         { os << t } -> std::same_as<std::ostream&>;
     };
 
-    std::string FormatTimestamp()
-    {
-        using namespace std::chrono;
-        const auto now = system_clock::now();
-        const auto time = system_clock::to_time_t(now);
-        std::tm tm{};
-#if defined(_WIN32)
-        localtime_s(&tm, &time);
-#else
-        localtime_r(&time, &tm);
-#endif
-        const auto milliseconds_since_epoch = duration_cast<milliseconds>(now.time_since_epoch());
-        const auto milliseconds_part = milliseconds_since_epoch % milliseconds(1000);
-        std::ostringstream oss;
-        oss << std::setfill('0')
-            << std::setw(2) << tm.tm_hour << "`"
-            << std::setw(2) << tm.tm_min << "``"
-            << std::setw(2) << tm.tm_sec << '.'
-            << std::setw(3) << milliseconds_part.count();
-        return oss.str();
-    }
-
-    std::string FormatSessionLabel()
-    {
-        using namespace std::chrono;
-        const auto now = system_clock::now();
-        const auto time = system_clock::to_time_t(now);
-        std::tm tm{};
-#if defined(_WIN32)
-        localtime_s(&tm, &time);
-#else
-        localtime_r(&time, &tm);
-#endif
-        std::ostringstream oss;
-        oss << std::setfill('0')
-            << std::setw(4) << (tm.tm_year + 1900)
-            << std::setw(2) << (tm.tm_mon + 1)
-            << std::setw(2) << tm.tm_mday << '_'
-            << std::setw(2) << tm.tm_hour
-            << std::setw(2) << tm.tm_min;
-        return oss.str();
-    }
-
-    const std::string& GetSessionLabel()
-    {
-        static const std::string label = FormatSessionLabel();
-        return label;
-    }
-
-    std::ofstream& GetLogFile()
-    {
-        static std::ofstream file;
-        static std::once_flag init_flag;
-        std::call_once(init_flag, []() {
-            std::error_code ec;
-            std::filesystem::path dir = std::filesystem::current_path() /".."/".."/".."/"reports";
-            std::filesystem::create_directories(dir, ec);
-            if (!ec) {
-                const std::string filename = "debug_log_" + GetSessionLabel() + ".txt";
-                std::filesystem::path path = dir / filename;
-                file.open(path, std::ios::app);
-            }
-        });
-        return file;
-    }
-
-    void AppendLogLine(const std::string& line) noexcept
-    {
-        std::ofstream& file = GetLogFile();
-        if (!file.is_open()) {
-            return;
-        }
-        static std::mutex mutex;
-        std::lock_guard<std::mutex> lg(mutex);
-        file << line << '\n';
-        file.flush();
-    }
-
+    // 调用线程只编码参数并入队，格式化与写文件/写 std::cerr 由 AsyncLogger 的写线程完成
     template<Streamable... Args>
     void OutputWithHeader(Header h, const Args&... args)
     {
-        std::ostringstream oss;
-        oss << "[" << FormatTimestamp() << "] ";
-        oss << "[" << h.header << "]";
-        ((oss << ' ' << args), ...);
-        const std::string line = oss.str();
-        AppendLogLine(line);
-        std::cerr << line << std::endl;
+        AsyncLogger::RecordBuilder builder(h.header);
+        (builder.Add(args), ...);
+        AsyncLogger::Post(builder.Get());
     }
 
     // 2. 修改 Output 函数，使其第一个参数为 Header 结构体
@@ -159,12 +159,42 @@ namespace {
     {
         OutputWithHeader({.header = "Debug Message"}, args...);
     }
+
+    // 4. 分类输出：省略 Header 时以类别名作为头部
+    template<Streamable... Args>
+    void LogOutput(LogCategory, Header h, const Args&... args)
+    {
+        OutputWithHeader(h, args...);
+    }
+
+    template<Streamable... Args>
+    void LogOutput(LogCategory c, const Args&... args)
+    {
+        OutputWithHeader({.header = LogCategoryName(c)}, args...);
+    }
 } // namespace
 
+// 编译期过滤在外层 if constexpr 完成，运行时类别掩码在参数求值之前检查
+#define MCG_LOG_AT(level, cat, call) \
+    do { \
+        if constexpr (LogCompiledIn(LogLevel::level, LogCategory::cat)) { \
+            if (LogRuntimeEnabled(LogCategory::cat)) { call; } \
+        } \
+    } while (0)
+
 // 宏定义：在调试版本中启用调试输出功能
-// 使用 __VA_OPT__ (C++20) 来处理可变参数
-#define OUTPUT(...) Output(__VA_ARGS__)
+// 用法：LOG_WARN(Physics, "msg", value) 或 LOG_TRACE(ObjManager, {"ObjManager::Create"}, "msg")
+#define LOG_ERROR(cat, ...) MCG_LOG_AT(Error, cat, LogOutput(LogCategory::cat, __VA_ARGS__))
+#define LOG_WARN(cat, ...) MCG_LOG_AT(Warn, cat, LogOutput(LogCategory::cat, __VA_ARGS__))
+#define LOG_INFO(cat, ...) MCG_LOG_AT(Info, cat, LogOutput(LogCategory::cat, __VA_ARGS__))
+#define LOG_TRACE(cat, ...) MCG_LOG_AT(Trace, cat, LogOutput(LogCategory::cat, __VA_ARGS__))
+// OUTPUT 保持原有用法，等价于 General 类别的 Info 级别
+#define OUTPUT(...) MCG_LOG_AT(Info, General, Output(__VA_ARGS__))
 #else
 // 宏定义：确保在发布版本中完全移除调用和参数求值
+#define LOG_ERROR(cat, ...) do {} while(0)
+#define LOG_WARN(cat, ...) do {} while(0)
+#define LOG_INFO(cat, ...) do {} while(0)
+#define LOG_TRACE(cat, ...) do {} while(0)
 #define OUTPUT(...) do {} while(0)
 #endif
\ No newline at end of file
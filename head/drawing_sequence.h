@@ -8,6 +8,7 @@
 #include <cstddef>
 
 #include <cute.h> // CF_Canvas
+#include "base_physics.h" // CF_ShapeWrapper
 
 class BaseObject;
 
@@ -17,21 +18,76 @@ public:
 
     static DrawingSequence& Instance() noexcept;
 
+    // Register/Unregister/OnDepthChanged 均为 O(1)：对象自己记录槽位下标（BaseObject::m_draw_slot），无需查表
     void Register(BaseObject* obj) noexcept;
     void Unregister(BaseObject* obj) noexcept;
+    // 由 BaseObject::SetDepth 调用，使绘制列表保持有序而无需每帧排序
+    void OnDepthChanged(BaseObject* obj) noexcept;
+    // 批量清空（房间卸载）：一次性丢弃全部条目并重置对象的槽位，随后的析构直接走"未注册"的 O(1) 路径
+    void UnregisterAll() noexcept;
+    // 为即将批量注册的对象预留槽位（ObjManager::CreateBatch 使用）
+    void Reserve(size_t additional);
 
     void DrawAll();
+    // 重放上一次 DrawAll 记录的调试图层（形状轮廓、manifold 接触点与法线）；SHAPE_DEBUG/COLLISION_DEBUG 关闭时为空操作
+    void DrawDebugOverlay();
 
+    // 记录模式（无窗口运行）：DrawAll 照常遍历有序列表并推进动画帧，但只统计本应提交的数量，不调用渲染器
+    void SetRecordOnly(bool record_only) noexcept;
+    bool IsRecordOnly() const noexcept { return m_record_only; }
+    // 上一次 DrawAll 提交或记录的精灵数（含 TileLayer 的格子）
+    size_t GetLastFrameSpriteCount() const noexcept { return m_last_frame_sprites; }
+
+    size_t GetRegisteredCount() const noexcept;
     size_t GetEstimatedMemoryUsageBytes() const noexcept;
 
 private:
+    // 槽位表条目；owner 为 nullptr 表示空闲槽位（其下标位于 m_free_slots）
     struct Entry {
         BaseObject* owner = nullptr;
         uint64_t reg_index = 0;
+        uint64_t stamp = 0; // 每次（重新）放入桶时递增
+        int depth = 0;
+    };
+
+    // 桶中的项记录槽位与插入时的 stamp。Unregister 与修改深度都不触碰桶：旧项的 stamp 不再与槽位匹配，
+    // 在下一次稳定压缩（DrawAll，或过期项累积过多时的 CompactBuckets）中被丢弃
+    struct BucketItem {
+        uint32_t slot = 0;
+        uint64_t stamp = 0;
+        uint64_t reg_index = 0;
     };
 
-    std::vector<std::unique_ptr<Entry>> m_entries;
+    // 同一深度的项，排序后按 reg_index 排列；各桶按深度有序
+    struct DepthBucket {
+        int depth = 0;
+        std::vector<BucketItem> items;
+        bool needs_sort = false; // 修改深度的条目追加后打乱了 reg_index 顺序时置位
+    };
+
+    bool IsLive(const BucketItem& item) const noexcept
+    {
+        const Entry& e = m_slots[item.slot];
+        return e.owner != nullptr && e.stamp == item.stamp;
+    }
+
+    void RecordDebugOverlay(const BaseObject* obj);
+    void BucketInsert(uint32_t slot);
+    void CompactBucket(DepthBucket& bucket);
+    void CompactBuckets();
+
+    std::vector<Entry> m_slots;
+    std::vector<uint32_t> m_free_slots;
+    std::vector<DepthBucket> m_buckets;
+    // 每帧的调试图层命令，按值保存在跨帧复用的缓冲中
+    std::vector<CF_ShapeWrapper> m_debug_shapes;
+    std::vector<CF_Manifold> m_debug_manifolds;
     mutable std::mutex m_mutex;
 
     uint64_t m_next_reg_index = 1;
+    uint64_t m_next_stamp = 1;
+    size_t m_live_count = 0;
+    size_t m_stale_items = 0;
+    size_t m_last_frame_sprites = 0;
+    bool m_record_only = false;
 };
\ No newline at end of file
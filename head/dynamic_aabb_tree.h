@@ -0,0 +1,146 @@
+#pragma once
+#include <cute.h>
+#include <array>
+#include <cstdint>
+#include <vector>
+
+// DynamicAabbTree —— 动态包围盒层次树（BVH），PhysicsSystem 的 DynamicTree broadphase 与空间查询使用：
+// - 每个代理（叶子）保存一个"胖"包围盒：紧包围盒四周各扩展 margin。物体在胖包围盒内移动时 MoveProxy 什么也不做，
+//   只有离开时才移除并重新插入，因此缓慢移动的物体（移动刺、樱桃、移动方块）几乎没有 broadphase 开销。
+// - 插入时按包围盒周长的增量选择兄弟节点，沿途通过旋转保持平衡，树高约为 O(log n)。
+// - 节点存放在连续数组中并通过空闲链表复用；代理 id 即节点下标，在代理销毁前保持不变，可用于旁路数组索引。
+// - 查询（Query / RayCast）只读取树，回调中不得增删代理。
+class DynamicAabbTree {
+public:
+    static constexpr int32_t kNull = -1;
+
+    // 创建代理并返回其 id；aabb 为紧包围盒，user_data 由调用方解释
+    int32_t CreateProxy(const CF_Aabb& aabb, uint64_t user_data, float margin);
+    void DestroyProxy(int32_t id) noexcept;
+    // 紧包围盒仍在胖包围盒内时返回 false；否则以新的胖包围盒重新插入并返回 true
+    bool MoveProxy(int32_t id, const CF_Aabb& aabb, float margin);
+    // 清空全部节点但保留容量
+    void Clear() noexcept;
+
+    // id 是否为当前有效的代理（叶子）
+    bool IsProxy(int32_t id) const noexcept
+    {
+        return id >= 0 && static_cast<size_t>(id) < nodes_.size() && nodes_[id].height == 0;
+    }
+    uint64_t GetUserData(int32_t id) const noexcept { return nodes_[id].user_data; }
+    const CF_Aabb& GetFatAabb(int32_t id) const noexcept { return nodes_[id].aabb; }
+
+    size_t ProxyCount() const noexcept { return proxy_count_; }
+    // 节点数组容量：代理 id 总小于该值，调用方可按它调整旁路数组的大小
+    size_t NodeCapacity() const noexcept { return nodes_.size(); }
+    int32_t Height() const noexcept { return root_ == kNull ? 0 : nodes_[root_].height; }
+
+    // 遍历胖包围盒与 box 重叠（含相切）的全部代理：fn(int32_t id)
+    template <typename Fn>
+    void Query(const CF_Aabb& box, Fn&& fn) const
+    {
+        Stack stack;
+        stack.Push(root_);
+        while (!stack.Empty()) {
+            const int32_t id = stack.Pop();
+            if (id == kNull) continue;
+            const Node& n = nodes_[id];
+            if (!Overlaps(n.aabb, box)) continue;
+            if (n.IsLeaf()) {
+                fn(id);
+            }
+            else {
+                stack.Push(n.child1);
+                stack.Push(n.child2);
+            }
+        }
+    }
+
+    // 线段 p0 -> p1 与胖包围盒相交的代理按树的顺序交给 fn(int32_t id, float max_fraction)，
+    // fn 返回新的最大分数（0..1）：返回更小的值可裁剪后续搜索（求最近命中），返回 0 终止，返回 max_fraction 不变则继续
+    template <typename Fn>
+    void RayCast(const CF_V2& p0, const CF_V2& p1, Fn&& fn) const
+    {
+        const CF_V2 d = cf_v2(p1.x - p0.x, p1.y - p0.y);
+        float max_fraction = 1.0f;
+        Stack stack;
+        stack.Push(root_);
+        while (!stack.Empty()) {
+            const int32_t id = stack.Pop();
+            if (id == kNull) continue;
+            const Node& n = nodes_[id];
+            float t = 0.0f;
+            if (!RayHitsAabb(p0, d, n.aabb, max_fraction, &t)) continue;
+            if (n.IsLeaf()) {
+                const float value = fn(id, max_fraction);
+                if (value <= 0.0f) return;
+                if (value < max_fraction) max_fraction = value;
+            }
+            else {
+                stack.Push(n.child1);
+                stack.Push(n.child2);
+            }
+        }
+    }
+
+    // 线段参数形式 p0 + d * t 与包围盒的相交测试（slab 法），t 限定在 [0, max_t]，命中时写入进入点的 t
+    static bool RayHitsAabb(const CF_V2& p0, const CF_V2& d, const CF_Aabb& box, float max_t, float* out_t) noexcept;
+
+    static bool Overlaps(const CF_Aabb& a, const CF_Aabb& b) noexcept
+    {
+        return a.min.x <= b.max.x && a.max.x >= b.min.x && a.min.y <= b.max.y && a.max.y >= b.min.y;
+    }
+    static bool Contains(const CF_Aabb& outer, const CF_Aabb& inner) noexcept
+    {
+        return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+    }
+
+private:
+    struct Node {
+        CF_Aabb aabb{};
+        uint64_t user_data = 0;
+        int32_t parent = kNull;
+        int32_t next = kNull;    // 空闲链表
+        int32_t child1 = kNull;
+        int32_t child2 = kNull;
+        int32_t height = -1;     // 叶子为 0，空闲节点为 -1
+        bool IsLeaf() const noexcept { return child1 == kNull; }
+    };
+
+    // 遍历用的栈：平衡树的深度很小，通常只用固定数组；极端情况下退回堆上的 vector
+    class Stack {
+    public:
+        void Push(int32_t id)
+        {
+            if (size_ < fixed_.size()) fixed_[size_] = id;
+            else overflow_.push_back(id);
+            ++size_;
+        }
+        int32_t Pop() noexcept
+        {
+            --size_;
+            if (size_ < fixed_.size()) return fixed_[size_];
+            const int32_t id = overflow_.back();
+            overflow_.pop_back();
+            return id;
+        }
+        bool Empty() const noexcept { return size_ == 0; }
+
+    private:
+        std::array<int32_t, 128> fixed_;
+        std::vector<int32_t> overflow_;
+        size_t size_ = 0;
+    };
+
+    int32_t AllocateNode();
+    void FreeNode(int32_t id) noexcept;
+    void InsertLeaf(int32_t leaf);
+    void RemoveLeaf(int32_t leaf) noexcept;
+    // 若以 a 为根的子树左右高度差超过 1 则旋转，返回旋转后该位置的子树根
+    int32_t Balance(int32_t a) noexcept;
+
+    std::vector<Node> nodes_;
+    int32_t root_ = kNull;
+    int32_t free_list_ = kNull;
+    size_t proxy_count_ = 0;
+};
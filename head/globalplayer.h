@@ -60,6 +60,9 @@ public:
 	// Ҵӳֵ򸴻㷵Ϸ߼
 	void Emerge();
 
+	//  R 伴ǰпʱԭػָ䲢·ң¼
+	void Revive();
+
 	// ЧѪٵǰʵ
 	void Hurt();
 
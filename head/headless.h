@@ -0,0 +1,86 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <bitset>
+#include <iosfwd>
+#include <cstddef>
+#include <cstdint>
+
+#include <cute_input.h> // CF_KEY_COUNT
+
+/*
+ * Headless — 无窗口模拟模式（用于在 CI 上测量游戏逻辑吞吐量）。
+ *
+ * 说明：
+ * - 以隐藏窗口、无图形、无音频的方式创建应用，挂载 content/，加载指定房间；
+ * - 每帧把脚本化输入写入 Input::SetScriptedKeys，然后尽可能快地依次执行
+ *   main_thread_on_update → ObjManager::UpdateAll → RoomLoader::UpdateCurrent → DrawingSequence::DrawAll，
+ *   其中 DrawingSequence 处于记录模式（只计数、不提交渲染）；
+ * - 结束后输出帧率与各阶段耗时（平均/最大），供性能回归检查使用。
+ *
+ * 命令行：
+ *   mygame --headless [--room <name>] [--frames <n>] [--input <script>]
+ *
+ * 输入脚本：每行 `<起始帧> <结束帧> <键名>...`（帧号从 0 开始、闭区间），`#` 开头为注释；
+ * 键名为 A-Z、SPACE、ESCAPE 等（见 headless.cpp 中的键名表）。未提供脚本时使用内置脚本：
+ * 一直按住 D 向右移动，每 40 帧按一次 SPACE 跳跃。
+ */
+namespace Headless {
+
+	struct Options {
+		std::string room;        // 为空时加载初始房间
+		int frames = 600;        // 模拟帧数
+		std::string input_path;  // 输入脚本路径（为空时使用内置脚本）
+	};
+
+	// 一段脚本输入：[first, last] 帧内按住 keys
+	struct InputSpan {
+		int first = 0;
+		int last = 0;
+		std::bitset<CF_KEY_COUNT> keys;
+	};
+
+	struct PhaseStats {
+		double total_ms = 0.0;
+		double max_ms = 0.0;
+		void Add(double ms) noexcept
+		{
+			total_ms += ms;
+			if (ms > max_ms) max_ms = ms;
+		}
+	};
+
+	struct Report {
+		std::string room;
+		int frames = 0;
+		double wall_ms = 0.0;
+		PhaseStats delegates; // main_thread_on_update
+		PhaseStats objects;   // ObjManager::UpdateAll（含物理）
+		PhaseStats room_update; // RoomLoader::UpdateCurrent
+		PhaseStats draw;      // DrawingSequence::DrawAll（记录模式）
+		uint64_t sprites_recorded = 0;
+		size_t objects_at_end = 0;
+		int respawns = 0;
+	};
+
+	// 解析命令行；存在 --headless 时返回 true 并填充 out
+	bool ParseArgs(int argc, char* argv[], Options& out) noexcept;
+
+	// 读取输入脚本（失败时返回 false，out 保持为空）
+	bool LoadInputScript(const std::string& path, std::vector<InputSpan>& out);
+	std::vector<InputSpan> DefaultInputScript(int frames);
+
+	// 创建无窗口应用并完成与 main 相同的全局初始化（挂载 content、设置世界边界）
+	// graphics 为 false 时不创建图形设备，DrawingSequence 切换到记录模式；
+	// 为 true 时保留隐藏窗口的图形设备，DrawAll 照常构建绘制命令（mygame_bench 使用）
+	bool InitApp(const char* argv0, bool graphics = false);
+	void ShutdownApp();
+
+	// 在已初始化的应用上运行一次模拟
+	Report Run(const Options& opt, const std::vector<InputSpan>& script);
+
+	void PrintReport(const Report& report, std::ostream& os);
+
+	// --headless 入口：初始化、运行、打印、退出，返回进程退出码
+	int Main(const Options& opt, const char* argv0);
+}
@@ -33,6 +33,27 @@ namespace Input {
 	inline bool MouseDown(CF_MouseButton& out_button) noexcept;
 	inline bool MouseButtonsDown(std::bitset<CF_MOUSE_BUTTON_COUNT>& out_buttons) noexcept;
 
+	// 脚本化键盘输入（无窗口模拟 / 基准测试使用）：
+	// 启用后 IsKeyInState 不再读取 cute_input，而是读取每帧由 SetScriptedKeys 提供的按下集合，
+	// edge 状态（Down/Up）由相邻两帧的集合比较得出。
+	struct ScriptedKeyState {
+		bool active = false;
+		std::bitset<CF_KEY_COUNT> prev;
+		std::bitset<CF_KEY_COUNT> cur;
+	};
+	inline ScriptedKeyState& Scripted() noexcept {
+		static ScriptedKeyState state;
+		return state;
+	}
+	// 每帧调用一次：down 为本帧处于按下状态的键集合
+	inline void SetScriptedKeys(const std::bitset<CF_KEY_COUNT>& down) noexcept {
+		ScriptedKeyState& s = Scripted();
+		s.prev = s.active ? s.cur : std::bitset<CF_KEY_COUNT>{};
+		s.cur = down;
+		s.active = true;
+	}
+	inline void ClearScriptedKeys() noexcept { Scripted() = ScriptedKeyState{}; }
+
 	inline void SetMouseHide(bool hide) { cf_mouse_hide(hide); }
 	inline bool IsMouseHidden() { return cf_mouse_hidden(); }
 
@@ -57,6 +78,26 @@ namespace Input {
 }
 
 inline bool Input::IsKeyInState(CF_KeyButton key, KeyState state) noexcept {
+	const ScriptedKeyState& scripted = Scripted();
+	if (scripted.active) {
+		const std::size_t i = static_cast<std::size_t>(key);
+		if (i >= scripted.cur.size()) return false;
+		const bool now = scripted.cur.test(i);
+		const bool before = scripted.prev.test(i);
+		switch (state) {
+		case KeyState::Up:
+			return before && !now;
+		case KeyState::Down:
+		case KeyState::Repeatable:
+			return now && !before;
+		case KeyState::Hold:
+			return now;
+		case KeyState::Hang:
+			return !now;
+		default:
+			return false;
+		}
+	}
 	switch (state) {
 	case KeyState::Up:
 		return cf_key_just_released(key);
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <functional>
+#include <initializer_list>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 #include <type_traits>
 #include <unordered_set>
@@ -10,6 +15,8 @@
 #include <cstddef>
 
 #include "object_token.h"
+#include "object_pool.h"
+#include "room_arena.h"
 
 #ifndef APPLIANCE
 #define APPLIANCE [[deprecated("APPLIANCE: 涉及物理量的每帧更新，已在类内部完成。除非你需要单帧内多次更新，否则请勿使用该接口。")]]
@@ -17,14 +24,19 @@
 
 // 前置声明，避免头文件循环依赖
 class BaseObject;
+struct RoomSnapshot;
 
 // ObjManager 为应用提供对象生命周期管理与句柄（token）系统，面向使用者说明：
 // - 提供基于 `ObjToken` 的对象引用与验证机制，避免裸指针悬挂问题。主流用法：
-//     auto tok = objs.Create<MyObject>(...); // 返回 pending token（pending id 存放在 token.index）
+//     auto tok = objs.Create<MyObject>(...); // 返回 pending token（token.index / generation 为 pending 解析表的槽位与代数）
 //     // 下一帧 UpdateAll 提交后，pending token 会被升级为真实 token（index -> objects_ 槽索引），可使用 TryGetRegisteration / operator[] 访问
 // - 支持延迟创建（CreateEntry 将对象放入 pending_creates_ 并立即调用 Start()，但直到下一帧 UpdateAll 才合并到 objects_ 且注册到 PhysicsSystem）
 //   这样做可避免在更新循环中动态分配导致迭代器失效，并允许在 pending 阶段提前访问对象（operator[] 直接查找 pending_creates_）。
 // - 支持延迟销毁（DestroyExisting 会将真实 token 入队，实际销毁在下一次 UpdateAll 的安全点执行；DestroyPending 会清理尚未合并的 pending）。
+// - 对象存储来自按类型的对象池（object_pool.h）：Create<T> 从 T 的池中分配，销毁时归还槽位，对象地址在生命周期内稳定。
+//   RoomScope 期间（房间的 RoomLoad）创建的对象改为放入房间 arena（room_arena.h），DestroyAll 时整体重置。
+// - 房间快照（room_snapshot.h）：LoadRoom 结束时记录房间对象的初始状态，重生时 RestoreRoomSnapshot 原地恢复，
+//   只重建状态偏离的对象，避免整房间卸载再加载。
 // - UpdateAll() 是统一的帧更新入口，职责包括：FrameEnterApply、PhysicsSystem::Step、Update、FrameExitApply、处置销毁、提交 pending-create，并支持 skip_update_this_frame 标记跳过当帧更新。
 // 语义契约：
 // - ObjManager 的大部分接口不是线程安全的，应在主线程的游戏循环中使用。
@@ -37,6 +49,8 @@ public:
     ObjManager& operator=(const ObjManager&) = delete;
 
     using ObjToken = ::ObjToken;
+    // 房间快照中的对象配方：以相同的构造参数重新 Create 该对象
+    using RoomRecipe = std::function<ObjToken(ObjManager&)>;
 
     // Create: 立即构造对象并调用 Start()，但对象会被放入 pending_creates_，直到下一帧 UpdateAll 的提交阶段才合并到 objects_ 并返回真正的 index/generation。
     // 返回 PendingToken 便于调用者追踪对象。pending token 既可在 pending 阶段通过 operator[] 或 TryGetRegisteration 访问。
@@ -44,10 +58,78 @@ public:
     ObjToken Create(Args&&... args)
     {
         static_assert(std::is_base_of<BaseObject, T>::value, "T must derive from BaseObject");
-        auto obj = std::make_unique<T>(std::forward<Args>(args)...);
-        return CreateEntry(std::unique_ptr<BaseObject>(static_cast<BaseObject*>(obj.release())));
+        if (room_scope_depth_ > 0) {
+            // 先拷贝构造参数作为快照配方，再转发给构造函数
+            RoomRecipe recipe = MakeRoomRecipe<T>(args...);
+            T* obj = room_arena_.Construct<T>(std::forward<Args>(args)...);
+            ObjToken token = CreateEntry(ObjectPtr(obj, PoolDeleter{ &room_arena_ }));
+            if (token.isValid()) RecordRoomRecipe(token, std::move(recipe));
+            return token;
+        }
+        ObjectPool<T>& pool = PoolFor<T>();
+        T* obj = pool.Construct(std::forward<Args>(args)...);
+        return CreateEntry(ObjectPtr(obj, PoolDeleter{ &pool }));
     }
 
+    // CreateBatch：为 args_list 中的每个元素创建一个 T；元素为 std::tuple / std::pair 时展开为构造参数，否则作为唯一参数。
+    // 语义与逐个 Create<T> 相同（立即 Start、下一帧 UpdateAll 提交），但事先为对象池、pending 表与绘制序列一次性预留容量，
+    // 提交阶段按创建顺序连续写入 objects_ 并为物理系统整批预留表空间。返回的 token 与 args_list 顺序一致。
+    //     objs.CreateBatch<Spike>(positions);                                   // std::vector<CF_V2>
+    //     objs.CreateBatch<BlockObject>({ std::tuple{ p0, false }, std::tuple{ p1, true } });
+    template <typename T, typename Range>
+    std::vector<ObjToken> CreateBatch(const Range& args_list)
+    {
+        static_assert(std::is_base_of<BaseObject, T>::value, "T must derive from BaseObject");
+        const size_t n = static_cast<size_t>(std::distance(std::begin(args_list), std::end(args_list)));
+        std::vector<ObjToken> tokens;
+        tokens.reserve(n);
+        ReserveCreates(n);
+        if (room_scope_depth_ == 0) PoolFor<T>().Reserve(n);
+        for (const auto& args : args_list) {
+            if constexpr (IsArgTuple<std::decay_t<decltype(args)>>::value) {
+                tokens.push_back(std::apply([this](const auto&... a) { return Create<T>(a...); }, args));
+            }
+            else {
+                tokens.push_back(Create<T>(args));
+            }
+        }
+        return tokens;
+    }
+    template <typename T, typename A>
+    std::vector<ObjToken> CreateBatch(std::initializer_list<A> args_list)
+    {
+        return CreateBatch<T, std::initializer_list<A>>(args_list);
+    }
+
+    // 按池内存顺序访问 T 类型的全部存活对象（包含尚未提交的 pending 对象）；回调中不得创建或销毁 T 类型对象
+    template <typename T, typename F>
+    void ForEachOfType(F&& fn)
+    {
+        PoolFor<T>().ForEach(std::forward<F>(fn));
+    }
+
+    // 释放各类型对象池中完全空闲的块，返回释放的块数
+    size_t TrimPools() noexcept;
+
+    // 房间作用域：存活期间 Create 的对象放入房间 arena（BaseRoom::LoadRoom 包裹 RoomLoad 使用）
+    // 这些对象与其它对象一样可以单独销毁；房间卸载时由 DestroyAll 统一析构并整体重置 arena
+    class RoomScope {
+    public:
+        RoomScope() noexcept { ObjManager::Instance().EnterRoomScope(); }
+        ~RoomScope() noexcept { --ObjManager::Instance().room_scope_depth_; }
+        RoomScope(const RoomScope&) = delete;
+        RoomScope& operator=(const RoomScope&) = delete;
+    };
+
+    // 房间快照：
+    // - CaptureRoomSnapshot：为最近一次 RoomScope 内创建的对象记录基础状态（BaseRoom::LoadRoom 在 RoomLoad 返回后调用）
+    // - RestoreRoomSnapshot：原地恢复到快照状态，返回 false 表示没有可用快照或有偏离对象无法重建（调用方应整房间重载）
+    // - ExcludeFromRoomSnapshot：把对象移出快照（如玩家，由 GlobalPlayer 自行重生），恢复时与其它快照外对象一样被销毁
+    void CaptureRoomSnapshot() noexcept;
+    bool RestoreRoomSnapshot() noexcept;
+    void ExcludeFromRoomSnapshot(const ObjToken& token) noexcept;
+    bool HasRoomSnapshot() const noexcept;
+
     // 验证 token 是否为当前有效的已合并对象（不考虑 pending 情况）
     bool IsValid(const ObjToken& token) const noexcept;
 
@@ -63,7 +145,7 @@ public:
 	// - 非 const 版本会在成功时用真实 token 覆盖输入 token 并返回 true（caller 可继续用该 token 访问对象）
     // TryGetRegisteration:
     // - 非 const 版本会修改 pending token，将其替换为真实 token（若已合并），并返回是否有效。
-    // - const 版本仅查询 pending->real 映射或验证已注册 token，不会修改输入。
+    // - const 版本仅查询 pending 解析表或验证已注册 token，不会修改输入。
     bool TryGetRegisteration(ObjToken& token) const noexcept;
     bool TryGetRegisteration(const ObjToken& token) const noexcept;
 
@@ -72,7 +154,7 @@ public:
     void Destroy(const ObjToken& p) noexcept;
 
     // DestroyAll: 立即销毁所有对象并清理所有挂起队列，通常在程序退出或重置时调用。
-    // - 会调用每个对象的 OnDestroy、反注册 PhysicsSystem 并让所有 token 失效。
+    // - 会调用每个对象的 OnDestroy 并让所有 token 失效；物理与绘制表整体清空（不逐个反注册），房间 arena 整体重置，房间快照作废。
     void DestroyAll() noexcept;
 
     // UpdateAll: 每帧主更新入口，顺序：
@@ -93,9 +175,52 @@ private:
     ObjManager() noexcept;
     ~ObjManager() noexcept;
 
+    // 对象由所属类型的池分配，释放时经 PoolDeleter 归还
+    using ObjectPtr = std::unique_ptr<BaseObject, PoolDeleter>;
+
+    // 每种类型的池在首次 Create<T> 时创建并由 ObjManager 持有（函数内静态指针只做缓存，避免每次查表）
+    template <typename T>
+    ObjectPool<T>& PoolFor()
+    {
+        static ObjectPool<T>* pool = static_cast<ObjectPool<T>*>(RegisterPool(std::make_unique<ObjectPool<T>>()));
+        return *pool;
+    }
+    ObjectPoolBase* RegisterPool(std::unique_ptr<ObjectPoolBase> pool);
+
+    // CreateBatch 的参数分派：tuple / pair 展开为多个构造参数
+    template <typename U> struct IsArgTuple : std::false_type {};
+    template <typename... U> struct IsArgTuple<std::tuple<U...>> : std::true_type {};
+    template <typename U1, typename U2> struct IsArgTuple<std::pair<U1, U2>> : std::true_type {};
+
+    // 批量创建前为 pending 表、快照与绘制序列预留 n 个条目
+    void ReserveCreates(size_t n);
+
+    // 拷贝构造参数生成配方；存在不可拷贝的参数时返回空配方
+    template <typename T, typename... Args>
+    static RoomRecipe MakeRoomRecipe(const Args&... args)
+    {
+        if constexpr ((std::is_copy_constructible_v<std::decay_t<Args>> && ...)) {
+            return [saved = std::tuple<std::decay_t<Args>...>(args...)](ObjManager& m) {
+                return std::apply([&m](const auto&... a) { return m.Create<T>(a...); }, saved);
+            };
+        }
+        else {
+            return {};
+        }
+    }
+    // 最外层 RoomScope 打开时清空上一份快照并开始录制配方
+    void EnterRoomScope() noexcept;
+    void RecordRoomRecipe(const ObjToken& token, RoomRecipe recipe);
+    // 按 token（pending 或已注册）取得对象指针，找不到时返回 nullptr；已提交的 pending token 会被升级为真实 token
+    BaseObject* ResolveObject(ObjToken& token) noexcept;
+
+    static constexpr uint32_t kNoPendingSlot = 0xFFFFFFFFu;
+
     struct Entry {
-        std::unique_ptr<BaseObject> ptr;
+        ObjectPtr ptr;
         uint32_t generation = 0;
+        // 创建该对象时占用的 pending 解析槽位，对象销毁时释放
+        uint32_t pending_slot = kNoPendingSlot;
         bool alive = false;
         // 新增：创建当帧跳过 FramelyUpdate 的标志（用于合并时可能需要跳过本帧更新）
         bool skip_update_this_frame = false;
@@ -104,9 +229,30 @@ private:
     // pending create 的中间结构：在 CreateEntry 时只把对象放到这里（不直接扩展 objects_），
     // 在 UpdateAll 的提交阶段再把它们合并到 objects_（安全点，避免在更新循环中重分配）
     struct PendingCreate {
-        std::unique_ptr<BaseObject> ptr;
+        ObjectPtr ptr; // 在 pending 阶段被销毁后为空，提交时跳过
+        uint32_t slot = kNoPendingSlot;
+    };
+
+    // pending 解析表的槽位：pending token 的 index 为槽位下标、generation 为槽位代数。
+    // 槽位在 Create 时占用，提交后记录真实 token，直到对象被销毁才释放（代数递增，旧的 pending token 随之失效），
+    // 因此表长不超过同时存活的对象数，创建、解析、销毁均为 O(1) 且无需哈希。
+    // 槽位代数从 2 开始、每次加 2，始终为非零偶数；objects_ 中存活条目的代数总是奇数（提交与销毁各递增一次），
+    // 因此 pending token 即使 index 与某个存活对象相同，也不会被 IsValid / operator[] / operator== 当作该对象。
+    static constexpr uint32_t kPendingGenerationStep = 2;
+    struct PendingSlot {
+        ObjToken real = ObjToken::Invalid();    // 提交后的真实 token
+        uint32_t create_pos = kNoPendingSlot;   // 尚未提交时在 pending_creates_ 中的下标
+        uint32_t generation = kPendingGenerationStep;
+        bool in_use = false;
     };
 
+    uint32_t AcquirePendingSlot();
+    void ReleasePendingSlot(uint32_t slot) noexcept;
+    // token 指向仍在使用的槽位（index 与 generation 均匹配）时返回该槽位
+    const PendingSlot* FindPendingSlot(const ObjToken& token) const noexcept;
+    // pending 阶段（尚未提交）的对象，找不到时返回 nullptr
+    BaseObject* FindPendingObject(const ObjToken& token) const noexcept;
+
     // 内部立即销毁实现（按 index）。
     // - DestroyEntry 调用对象 OnDestroy、反注册 PhysicsSystem、清理映射并使 token 失效
     void DestroyEntry(uint32_t index) noexcept;
@@ -115,9 +261,17 @@ private:
     // DestroyExisting: 将销毁请求入队（对于已合并对象），实际删除在下一次 UpdateAll 时执行；对于 pending 对象请使用 DestroyPending。
     void DestroyExisting(const ObjToken& token) noexcept;
 
-    // 将 unique_ptr<BaseObject> 的对象纳入管理并在必要时调用 Start()，返回 PendingToken 表示创建请求。
-    // 对象会被放入 pending_creates_（带 id），在 UpdateAll 的提交阶段合并到 objects_ 并完成物理注册。
-    ObjToken CreateEntry(std::unique_ptr<BaseObject> obj);
+    // 将池中分配的对象纳入管理并在必要时调用 Start()，返回 PendingToken 表示创建请求。
+    // 对象会被放入 pending_creates_（并占用一个 pending 解析槽位），在 UpdateAll 的提交阶段合并到 objects_ 并完成物理注册。
+    ObjToken CreateEntry(ObjectPtr obj);
+
+    // 按类型的对象池与房间 arena；声明在 objects_ 之前，保证析构时对象先于存储释放
+    std::vector<std::unique_ptr<ObjectPoolBase>> pools_;
+    RoomArena room_arena_;
+    int room_scope_depth_ = 0;
+
+    // 当前房间的快照（RoomScope 打开时重新开始录制）
+    std::unique_ptr<RoomSnapshot> room_snapshot_;
 
     // 存储对象条目
     std::vector<Entry> objects_;
@@ -132,15 +286,12 @@ private:
     std::vector<ObjToken> pending_destroys_;
     std::unordered_set<uint64_t> pending_destroy_set_; // compact key: ((uint64_t)index<<32)|generation
 
-    // 本帧刚创建但尚未合并到 objects_ 的对象存储（pending 创建区）
-    std::unordered_map<uint32_t, PendingCreate> pending_creates_; // key = pending id
-    std::unordered_map<BaseObject*, uint32_t> pending_ptr_to_id_; // ptr -> pending id 快速查找
-
-    // pending id -> 已合并后的真实 ObjToken（合并完成后写入，便于 ResolvePending）
-    std::unordered_map<uint32_t, ObjToken> pending_to_real_map_;
+    // 本帧刚创建但尚未合并到 objects_ 的对象（按创建顺序，提交后清空并保留容量）
+    std::vector<PendingCreate> pending_creates_;
 
-    // 下一个 pending id（单调递增）
-    uint32_t next_pending_id_ = 1;
+    // pending 解析表（pending token -> pending 对象 / 真实 token）与其空闲槽位
+    std::vector<PendingSlot> pending_slots_;
+    std::vector<uint32_t> free_pending_slots_;
 
     // 当前存活对象计数（包含 pending 创建）
     size_t alive_count_ = 0;
@@ -0,0 +1,190 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+class BaseObject;
+
+// ObjectPoolBase / ObjectPool<T> —— ObjManager 的按类型对象池：
+// - 每种对象类型一个池，存储按块（chunk）分配，每块容纳 kChunkSlots 个对象；块一经分配不再移动，
+//   因此对象地址在其生命周期内保持稳定（BaseObject*、ObjToken 均不受影响）。
+// - 销毁对象时只调用析构并把槽位放回空闲表，不释放内存；后续同类型的 Create 直接复用该槽位，
+//   避免频繁创建/销毁的对象（子弹、血液粒子、尖刺等）反复进出全局分配器。
+// - 同类型对象集中在少数几个连续的块中，ForEach 按块顺序遍历存活对象。
+// - 非线程安全，与 ObjManager 一样只在主线程使用。
+class ObjectPoolBase {
+public:
+    virtual ~ObjectPoolBase() noexcept = default;
+
+    // 析构对象并归还槽位（p 必须由本池分配）
+    virtual void Destroy(BaseObject* p) noexcept = 0;
+    // 释放全部槽位均空闲的块，返回释放的块数
+    virtual size_t Trim() noexcept = 0;
+
+    virtual const char* TypeName() const noexcept = 0;
+    virtual size_t LiveCount() const noexcept = 0;
+    virtual size_t ReservedBytes() const noexcept = 0;
+};
+
+// unique_ptr 的删除器：把对象交还给分配它的池
+struct PoolDeleter {
+    ObjectPoolBase* pool = nullptr;
+    void operator()(BaseObject* p) const noexcept
+    {
+        if (p && pool) pool->Destroy(p);
+    }
+};
+
+template <typename T>
+class ObjectPool final : public ObjectPoolBase {
+public:
+    // 每块约 16KB，且至少 8 个槽位
+    static constexpr size_t kChunkSlots = std::max<size_t>(8, 16384 / sizeof(T));
+
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    ~ObjectPool() noexcept override
+    {
+        // 正常情况下对象已由 ObjManager 全部销毁；此处兜底析构残留对象
+        for (auto& chunk : m_chunks) {
+            for (Slot& s : chunk->slots) {
+                if (s.live) s.Object()->~T();
+            }
+        }
+    }
+
+    // 在空闲槽位上构造对象；构造函数抛出时槽位归还并继续抛出
+    template <typename... Args>
+    T* Construct(Args&&... args)
+    {
+        Slot* s = AcquireSlot();
+        T* obj;
+        try {
+            obj = ::new (static_cast<void*>(s->storage)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            m_free.push_back(s);
+            throw;
+        }
+        s->live = true;
+        ++s->chunk->live_count;
+        ++m_live;
+        return obj;
+    }
+
+    // 预留至少 n 个可用槽位（批量创建前调用）：不足部分一次性分配新块并整块放入空闲表，
+    // 空闲表按地址逆序压入，随后的 Construct 按地址顺序取用
+    void Reserve(size_t n)
+    {
+        size_t available = m_free.size() + (m_bump_chunk ? kChunkSlots - m_bump_next : 0);
+        if (available >= n) return;
+        const size_t chunks = (n - available + kChunkSlots - 1) / kChunkSlots;
+        m_free.reserve(m_free.size() + chunks * kChunkSlots);
+        for (size_t c = 0; c < chunks; ++c) {
+            m_chunks.push_back(std::make_unique<Chunk>());
+            Chunk* chunk = m_chunks.back().get();
+            for (size_t i = kChunkSlots; i-- > 0; ) {
+                chunk->slots[i].chunk = chunk;
+                m_free.push_back(&chunk->slots[i]);
+            }
+        }
+    }
+
+    // 对象位于槽位起始处，由对象地址直接得到槽位，O(1)
+    void Destroy(BaseObject* p) noexcept override
+    {
+        T* obj = static_cast<T*>(p);
+        Slot* s = reinterpret_cast<Slot*>(obj);
+        if (!s->live) return;
+        obj->~T();
+        s->live = false;
+        --s->chunk->live_count;
+        --m_live;
+        m_free.push_back(s);
+    }
+
+    size_t Trim() noexcept override
+    {
+        size_t released = 0;
+        for (size_t c = 0; c < m_chunks.size(); ) {
+            Chunk* chunk = m_chunks[c].get();
+            if (chunk->live_count != 0) { ++c; continue; }
+            m_free.erase(std::remove_if(m_free.begin(), m_free.end(),
+                [chunk](const Slot* s) { return s->chunk == chunk; }), m_free.end());
+            if (m_bump_chunk == chunk) { m_bump_chunk = nullptr; m_bump_next = 0; }
+            m_chunks.erase(m_chunks.begin() + static_cast<std::ptrdiff_t>(c));
+            ++released;
+        }
+        return released;
+    }
+
+    // 按块顺序访问全部存活对象（包含尚未提交的 pending 对象）
+    template <typename F>
+    void ForEach(F&& fn)
+    {
+        for (auto& chunk : m_chunks) {
+            if (chunk->live_count == 0) continue;
+            for (Slot& s : chunk->slots) {
+                if (s.live) fn(*s.Object());
+            }
+        }
+    }
+
+    const char* TypeName() const noexcept override { return typeid(T).name(); }
+    size_t LiveCount() const noexcept override { return m_live; }
+    size_t CapacitySlots() const noexcept { return m_chunks.size() * kChunkSlots; }
+    size_t ReservedBytes() const noexcept override
+    {
+        return m_chunks.size() * sizeof(Chunk) + m_free.capacity() * sizeof(Slot*)
+            + m_chunks.capacity() * sizeof(std::unique_ptr<Chunk>);
+    }
+
+private:
+    struct Chunk;
+
+    // 对象存储放在槽位开头（偏移 0），其后是所属块与存活标记
+    struct Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Chunk* chunk = nullptr;
+        bool live = false;
+
+        T* Object() noexcept { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    struct Chunk {
+        Slot slots[kChunkSlots];
+        size_t live_count = 0;
+    };
+
+    // 优先复用空闲表（LIFO，刚释放的槽位仍在缓存中），其次使用当前块的未用部分，最后分配新块
+    Slot* AcquireSlot()
+    {
+        if (!m_free.empty()) {
+            Slot* s = m_free.back();
+            m_free.pop_back();
+            return s;
+        }
+        if (!m_bump_chunk || m_bump_next >= kChunkSlots) {
+            m_chunks.push_back(std::make_unique<Chunk>());
+            m_bump_chunk = m_chunks.back().get();
+            m_bump_next = 0;
+        }
+        Slot* s = &m_bump_chunk->slots[m_bump_next++];
+        s->chunk = m_bump_chunk;
+        return s;
+    }
+
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<Slot*> m_free;
+    Chunk* m_bump_chunk = nullptr;
+    size_t m_bump_next = 0;
+    size_t m_live = 0;
+};
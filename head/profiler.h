@@ -0,0 +1,110 @@
+#pragma once
+#include "debug_config.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/*
+ * Profiler — 帧阶段分析器（RAII 区段 + 每线程环形缓冲 + Chrome trace 导出）。
+ *
+ * 说明：
+ * - PROFILE_ZONE("name") 在当前作用域开始/结束时记录一个区段；name 必须是生命周期足够长的字符串
+ *   （字面量或 typeid(...).name()），缓冲区只保存指针。
+ * - 每个线程首次记录时获得自己的环形缓冲（kRingCapacity 个区段），写入无锁；缓冲写满后覆盖最旧的区段。
+ * - PROFILE_FRAME_MARK() 在每帧开头调用，用于划分帧与驱动捕获：RequestCapture(n, path) 之后的下一帧开始，
+ *   连续 n 帧结束时把这段时间内的区段导出为 Chrome trace JSON（chrome://tracing 或 Perfetto 打开）。
+ * - 由 MCG_PROFILE 控制（见 debug_config.h），关闭时所有宏展开为空语句，不产生任何开销。
+ */
+class Profiler {
+public:
+    static constexpr size_t kRingCapacity = 1u << 16;
+
+    struct Zone {
+        const char* name = nullptr;
+        uint64_t begin_ns = 0;
+        uint64_t end_ns = 0;
+    };
+
+    static Profiler& Instance() noexcept;
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // 距分析器启动的纳秒数
+    uint64_t NowNs() const noexcept
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_epoch).count());
+    }
+
+    // 记录一个已结束的区段（由 ProfileScope 析构时调用）
+    void Record(const char* name, uint64_t begin_ns, uint64_t end_ns) noexcept;
+
+    // 帧开始标记：推进帧计数并处理捕获窗口
+    void FrameMark() noexcept;
+
+    // 请求捕获接下来的 frames 帧，结束后写入 path
+    void RequestCapture(int frames, std::string path);
+    bool IsCapturing() const noexcept { return m_capture_active; }
+
+    // 提前结束正在进行的捕获并导出（程序退出时调用）
+    void FinishCapture() noexcept;
+
+private:
+    Profiler() noexcept;
+    ~Profiler() noexcept = default;
+
+    struct ThreadBuffer {
+        uint32_t tid = 0;
+        std::vector<Zone> zones;           // 环形缓冲
+        std::atomic<uint64_t> written{ 0 }; // 已写入总数（取模得到写入位置）
+    };
+
+    ThreadBuffer& LocalBuffer() noexcept;
+    bool ExportChromeTrace(const std::string& path, uint64_t begin_ns, uint64_t end_ns) const;
+
+    std::chrono::steady_clock::time_point m_epoch;
+    mutable std::mutex m_mutex; // 保护 m_buffers 列表与捕获状态
+    std::vector<std::unique_ptr<ThreadBuffer>> m_buffers;
+    std::vector<uint64_t> m_frame_marks; // 捕获窗口内每帧开始的时间
+
+    uint64_t m_frame_index = 0;
+    int m_capture_requested = 0;
+    int m_capture_remaining = 0;
+    bool m_capture_active = false;
+    uint64_t m_capture_begin_ns = 0;
+    std::string m_capture_path;
+};
+
+// RAII 区段：构造时记录开始时间，析构时写入当前线程的环形缓冲
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name) noexcept
+        : m_name(name), m_begin(Profiler::Instance().NowNs()) {}
+    ~ProfileScope() noexcept { Profiler::Instance().Record(m_name, m_begin, Profiler::Instance().NowNs()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* m_name;
+    uint64_t m_begin;
+};
+
+#define PROFILE_CONCAT_IMPL(x, y) x##y
+#define PROFILE_CONCAT(x, y) PROFILE_CONCAT_IMPL(x, y)
+
+#if MCG_PROFILE
+#define PROFILE_ZONE(name) ProfileScope PROFILE_CONCAT(profile_zone_, __LINE__)(name)
+#define PROFILE_FRAME_MARK() Profiler::Instance().FrameMark()
+#else
+// 关闭时不求值参数
+#define PROFILE_ZONE(name) do {} while(0)
+#define PROFILE_FRAME_MARK() do {} while(0)
+#endif
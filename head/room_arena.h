@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "object_pool.h"
+
+// RoomArena —— 房间作用域的对象存储：
+// - ObjManager 在 RoomScope 期间（BaseRoom::LoadRoom 调用 RoomLoad 时）把 Create<T> 的对象放到这里，
+//   存储按大块顺序分配（bump），同一房间的对象在内存中紧密相连。
+// - 单个对象被销毁时只运行析构函数，不回收空间；房间卸载（ObjManager::DestroyAll）析构全部对象后，
+//   Reset() 一次性把所有块的游标归零，块本身保留给下一个房间复用，重生/切换房间时不再逐个释放内存。
+// - 对象均为多态类型（虚析构），析构函数始终会被调用，arena 省去的是逐对象的释放与空闲表维护。
+class RoomArena final : public ObjectPoolBase {
+public:
+    static constexpr size_t kBlockBytes = 256 * 1024;
+
+    RoomArena() = default;
+    RoomArena(const RoomArena&) = delete;
+    RoomArena& operator=(const RoomArena&) = delete;
+    ~RoomArena() noexcept override = default;
+
+    // 在 arena 中构造对象；构造函数抛出时已占用的空间留到下次 Reset 回收
+    template <typename T, typename... Args>
+    T* Construct(Args&&... args)
+    {
+        void* mem = Allocate(sizeof(T), alignof(T));
+        T* obj = ::new (mem) T(std::forward<Args>(args)...);
+        ++m_live;
+        return obj;
+    }
+
+    // 只析构，不回收空间
+    void Destroy(BaseObject* p) noexcept override;
+
+    // 全部对象已析构后，把所有块的游标归零（存活对象不为零时拒绝重置）
+    bool Reset() noexcept;
+
+    // 只保留第一个块（仅在没有存活对象时生效），返回释放的块数
+    size_t Trim() noexcept override;
+
+    const char* TypeName() const noexcept override { return "RoomArena"; }
+    size_t LiveCount() const noexcept override { return m_live; }
+    size_t ReservedBytes() const noexcept override;
+    size_t UsedBytes() const noexcept;
+
+private:
+    struct Block {
+        std::unique_ptr<std::byte[]> data;
+        size_t size = 0;
+        size_t used = 0;
+    };
+
+    void* Allocate(size_t bytes, size_t align);
+
+    std::vector<Block> m_blocks;
+    size_t m_current = 0; // 当前分配所在的块
+    size_t m_live = 0;
+};
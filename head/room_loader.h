@@ -10,6 +10,9 @@
 #include "debug_config.h"
 #include "delegate.h"
 #include "obj_manager.h"
+#include "base_physics.h"
+#include "sprite_cache.h"
+#include "profiler.h"
 
 extern Delegate<> main_thread_on_update;
 
@@ -22,9 +25,18 @@ public:
 	virtual void RoomUpdate() {}
 	virtual void RoomUnload() {}
 
+	// ʹõ broadphaseԶӻһķɸ SweepAndPruneƶɸ DynamicTree
+	virtual BroadphaseType Broadphase() const noexcept { return BroadphaseType::Grid; }
+
 	void LoadRoom() {
-		// ÷߼
-		RoomLoad();
+		PhysicsSystem::Instance().SetBroadphase(Broadphase());
+		// ÷߼ڼ䴴Ķ뷿 arenaжʱͷ
+		{
+			ObjManager::RoomScope scope;
+			RoomLoad();
+		}
+		// ¼ʱĶ״̬ԭRoomLoader::Restoreʹ
+		ObjManager::Instance().CaptureRoomSnapshot();
 	}
 
 	void UnloadRoom() {
@@ -49,17 +61,31 @@ public:
 
 	// ͨüط
 	void Load(const BaseRoom& room) {
+		PROFILE_ZONE("RoomLoader::Load");
 		if (current_room_) {
 			current_room_->get().UnloadRoom();
 		}
 		current_room_ = std::ref(const_cast<BaseRoom&>(room));
 		current_room_->get().LoadRoom();
+		// ·Ķȫжزٱκζõľ飨乲õԴᱻ½룩
+		SpriteCache::Instance().ReleaseUnused();
+	}
+
+	// ԭroom ΪǰҴڿʱѷָռɵ״̬ true RoomUnload/RoomLoad
+	// δƫĶ뾫ԭ false ʱ÷Ӧ Load ¼
+	bool Restore(const BaseRoom& room) {
+		PROFILE_ZONE("RoomLoader::Restore");
+		if (!current_room_ || &current_room_->get() != &room) return false;
+		if (!ObjManager::Instance().HasRoomSnapshot()) return false;
+		// ЭֻڶҲŹĶ󶼻ᱻ´գ´Ķ Start ٴι
+		main_thread_on_update.clear();
+		return ObjManager::Instance().RestoreRoomSnapshot();
 	}
 
 	// ͨƼط
 	void Load(const std::string& room_name) {
 		Load(*GetRoomByName(room_name));
-		OUTPUT({ "RoomLoader::Load" }, "Loaded room:", room_name);
+		LOG_INFO(Room, { "RoomLoader::Load" }, "Loaded room:", room_name);
 	}
 
 	// سʼ
@@ -74,7 +100,7 @@ public:
 			return;
 		}
 
-		OUTPUT({ "RoomLoader::LoadInitial" }, "No rooms registered to load initial room.");
+		LOG_WARN(Room, { "RoomLoader::LoadInitial" }, "No rooms registered to load initial room.");
 	}
 
 	// µǰ
@@ -82,13 +108,13 @@ public:
 		if (current_room_) {
 			current_room_->get().RoomUpdate();
 		}
-		else OUTPUT({ "RoomLoader::UpdateCurrent" }, "No current room to update.");
+		else LOG_WARN(Room, { "RoomLoader::UpdateCurrent" }, "No current room to update.");
 	}
 
 	// жصǰ
 	void UnloadCurrent() {
 		if (!current_room_) {
-			OUTPUT({ "RoomLoader::UnloadCurrent" }, "No current room to unload.");
+			LOG_WARN(Room, { "RoomLoader::UnloadCurrent" }, "No current room to unload.");
 			return;
 		}
 		current_room_->get().UnloadRoom();
@@ -98,22 +124,22 @@ public:
 	// ע᷿䣬ظ򸲸ǣѡΪʼ
 	void RegisterRoom(const std::string& room_name, std::unique_ptr<BaseRoom> room, bool initial = false) {
 		if (room_name.empty() || !room) {
-			OUTPUT({ "RoomLoader::RegisterRoom" }, "Attempted to register room with empty name or null room pointer.");
+			LOG_WARN(Room, { "RoomLoader::RegisterRoom" }, "Attempted to register room with empty name or null room pointer.");
 			return;
 		}
 
 		auto [it, inserted] = rooms_.insert_or_assign(room_name, std::move(room));
 		if (!it->second) {
-			OUTPUT({ "RoomLoader::RegisterRoom" }, "Failed to register room:", room_name);
+			LOG_WARN(Room, { "RoomLoader::RegisterRoom" }, "Failed to register room:", room_name);
 			return;
 		}
 
 		if (initial) {
 			initial_room_ = std::ref(*it->second);
-			OUTPUT({ "RoomLoader::RegisterRoom" }, "Registered initial room:", room_name);
+			LOG_INFO(Room, { "RoomLoader::RegisterRoom" }, "Registered initial room:", room_name);
 		}
 
-		OUTPUT({ "RoomLoader::RegisterRoom" }, "Registered room:", room_name);
+		LOG_INFO(Room, { "RoomLoader::RegisterRoom" }, "Registered room:", room_name);
 	}
 
 	const BaseRoom* GetCurrentRoom() const noexcept {
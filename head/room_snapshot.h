@@ -0,0 +1,61 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "base_physics.h"
+#include "obj_manager.h"
+
+// RoomSnapshot —— 房间加载完成时的对象快照，用于原地重生（ObjManager::RestoreRoomSnapshot）：
+// - RoomScope 期间每个 Create<T> 记录一份"配方"（T 与构造参数的拷贝），BaseRoom::LoadRoom 结束时
+//   ObjManager::CaptureRoomSnapshot 再为每个对象记录一份可比较的基础状态（位置/速度/旋转/缩放/精灵等）。
+// - 重生时逐个比较：状态未变化的对象原地保留，只重置动画帧等瞬时量；状态偏离、已被销毁、
+//   或播放过 ActSeq（BaseObject::MarkStateDiverged）的对象按配方重新创建；快照外的对象（子弹、血迹、玩家）全部销毁。
+struct RoomSnapshot {
+    // 参与比较的基础状态（派生类的私有状态通过 MarkStateDiverged 上报）
+    struct State {
+        CF_V2 position{ 0.0f, 0.0f };
+        CF_V2 velocity{ 0.0f, 0.0f };
+        CF_V2 force{ 0.0f, 0.0f };
+        float rotation = 0.0f;
+        float scale_x = 1.0f;
+        float scale_y = 1.0f;
+        int depth = 0;
+        int anim_clip = -1;
+        bool visible = true;
+        ColliderType collider_type = ColliderType::VOID;
+        CollisionLayer collision_layer = CollisionLayer::Default;
+        std::string sprite_path;
+        // 仅 TileLayer：格子表。格子在 Create 之后才写入，配方无法重放，重建后由快照写回
+        std::vector<int16_t> tiles;
+        // 只在保留对象时恢复，不参与比较（动画帧每帧都在变化）
+        int sprite_frame_index = 0;
+
+        bool SameAs(const State& o) const noexcept
+        {
+            return position.x == o.position.x && position.y == o.position.y
+                && velocity.x == o.velocity.x && velocity.y == o.velocity.y
+                && force.x == o.force.x && force.y == o.force.y
+                && rotation == o.rotation && scale_x == o.scale_x && scale_y == o.scale_y
+                && depth == o.depth && anim_clip == o.anim_clip && visible == o.visible
+                && collider_type == o.collider_type && collision_layer == o.collision_layer
+                && sprite_path == o.sprite_path && tiles == o.tiles;
+        }
+    };
+
+    struct Entry {
+        ObjManager::ObjToken token;   // 当前对应的对象（重新创建后替换为新的 pending token）
+        ObjManager::RoomRecipe recipe; // 构造参数不可拷贝时为空，此时对象偏离后只能整房间重载
+        State state;
+    };
+
+    // 读取对象的当前状态；保留对象时清理帧间残留并恢复动画帧（需要访问 BaseObject 的私有成员）
+    static State Capture(const BaseObject& obj) noexcept;
+    static void ResetTransient(BaseObject& obj, const State& s) noexcept;
+    // 按配方重建后写回配方无法重放的部分（TileLayer 的格子）
+    static void ApplyRecreated(BaseObject& obj, const State& s) noexcept;
+
+    std::vector<Entry> entries;
+    bool captured = false; // LoadRoom 结束后置位；录制中（RoomLoad 尚未返回）不可恢复
+};
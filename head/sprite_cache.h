@@ -0,0 +1,60 @@
+#pragma once
+
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <cstddef>
+
+#include <cute.h> // CF_Sprite
+
+// SpriteCache：按路径引用计数的精灵资源缓存。
+// - 同一路径的 PNG 只解码一次，所有使用者共享同一个 easy sprite 图像 id；
+//   Acquire 返回 CF_Sprite 的值拷贝，使用者可以自由修改其 scale/offset/transform 而不影响他人。
+// - 每次 Acquire 必须对应一次 Release（BaseObject / TileLayer 内部已处理）。
+// - 引用计数归零后的释放时机由 ReleasePolicy 决定：
+//   - Immediate：最后一个使用者释放时立即卸载；
+//   - KeepUntilRoomLoad（默认）：保留到下一次房间加载完成后再统一卸载仍未被使用的条目，
+//     这样子弹/血液等反复创建的对象以及相邻房间共用的资源不会被反复解码。
+// 线程策略：与 ObjManager 相同，仅在主线程的游戏循环中使用。
+class SpriteCache {
+public:
+    enum class ReleasePolicy : uint8_t { Immediate, KeepUntilRoomLoad };
+
+    static SpriteCache& Instance() noexcept;
+
+    SpriteCache(const SpriteCache&) = delete;
+    SpriteCache& operator=(const SpriteCache&) = delete;
+
+    // 取得 path 对应的精灵（首次请求时加载），引用计数 +1
+    // 加载失败时返回 cf_sprite_defaults()（easy_sprite_id 为 0），且不增加引用计数
+    CF_Sprite Acquire(const std::string& path) noexcept;
+
+    // 引用计数 -1；归零后按释放策略卸载
+    void Release(const std::string& path) noexcept;
+
+    // 卸载所有引用计数为零的条目（RoomLoader 在房间加载完成后调用）
+    void ReleaseUnused() noexcept;
+
+    // 卸载全部条目（程序退出前调用）
+    void Clear() noexcept;
+
+    void SetReleasePolicy(ReleasePolicy p) noexcept;
+    ReleasePolicy GetReleasePolicy() const noexcept { return m_policy; }
+
+    // 调试/统计
+    size_t GetCachedCount() const noexcept { return m_entries.size(); }
+    int GetRefCount(const std::string& path) const noexcept;
+    size_t GetEstimatedMemoryUsageBytes() const noexcept;
+
+private:
+    SpriteCache() noexcept = default;
+    ~SpriteCache() noexcept = default;
+
+    struct Entry {
+        CF_Sprite sprite{};
+        int refs = 0;
+    };
+
+    std::unordered_map<std::string, Entry> m_entries;
+    ReleasePolicy m_policy = ReleasePolicy::KeepUntilRoomLoad;
+};
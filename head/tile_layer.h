@@ -0,0 +1,119 @@
+#pragma once
+#include "base_object.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+
+/*
+ * TileLayer — 网格对齐地形的单对象表示。
+ *
+ * 说明：
+ * - 每个格子保存一个 sprite 索引（指向构造时传入的调色板），kEmpty 表示空格，其余格子均视为实体（SOLID）。
+ * - 整个图层只占用一个 ObjManager 对象、一个 PhysicsSystem 条目和一个 DrawingSequence 条目：
+ *   - PhysicsSystem 不把图层放入网格，而是用动态物体的 AABB 直接按格子查询（CollideShape）；
+ *   - BaseObject 排斥固体时对重叠的每个格子逐一求解（见 BaseObject::ExclusionWithTiles）；
+ *   - DrawingSequence 在一次遍历中把所有非空格子作为同一批 sprite 提交。
+ * - 图层默认属于 Terrain 碰撞层并标记为静态，origin 为网格左下角的世界坐标。
+ * - 图层本身的 shape 是覆盖整张网格的 AABB，仅用于调试绘制与包围盒查询，不参与 narrowphase。
+ */
+class TileLayer : public BaseObject {
+public:
+    static constexpr int kEmpty = -1;
+
+    TileLayer(CF_V2 origin, int cols, int rows, float tile_size, std::vector<std::string> palette) noexcept
+        : BaseObject()
+        , m_origin(origin)
+        , m_cols(cols > 0 ? cols : 0)
+        , m_rows(rows > 0 ? rows : 0)
+        , m_tile_size(tile_size > 0.0f ? tile_size : 1.0f)
+        , m_palette_paths(std::move(palette))
+        , m_cells(static_cast<size_t>(m_cols) * static_cast<size_t>(m_rows), static_cast<int16_t>(kEmpty))
+    {
+    }
+    ~TileLayer() noexcept override;
+
+    void Start() override;
+
+    // 格子读写：越界写入被忽略，越界读取返回 kEmpty
+    void SetTile(int cx, int cy, int sprite_index) noexcept
+    {
+        if (!InRange(cx, cy)) return;
+        m_cells[Index(cx, cy)] = static_cast<int16_t>(sprite_index < 0 ? kEmpty : sprite_index);
+    }
+    int GetTile(int cx, int cy) const noexcept { return InRange(cx, cy) ? m_cells[Index(cx, cy)] : kEmpty; }
+    bool IsSolid(int cx, int cy) const noexcept { return GetTile(cx, cy) != kEmpty; }
+
+    // 以格子左下角的世界坐标写入（与 BlockObject 的 pivot(-1,-1) 摆放方式一致）
+    // 坐标未对齐网格或超出范围时返回 false，调用方可退回到独立对象
+    bool SetTileAt(CF_V2 bottom_left, int sprite_index) noexcept;
+
+    int Cols() const noexcept { return m_cols; }
+    int Rows() const noexcept { return m_rows; }
+    float TileSize() const noexcept { return m_tile_size; }
+    CF_V2 Origin() const noexcept { return m_origin; }
+
+    // 非空格子数量（DrawingSequence 记录模式下用于统计提交量）
+    size_t SolidCellCount() const noexcept
+    {
+        return static_cast<size_t>(std::count_if(m_cells.begin(), m_cells.end(), [](int16_t c) { return c != kEmpty; }));
+    }
+
+    // 整张格子表（行优先，cy * Cols() + cx）：房间快照据此保存与恢复 Create 之后写入的格子
+    const std::vector<int16_t>& Cells() const noexcept { return m_cells; }
+    void AssignCells(const std::vector<int16_t>& cells) noexcept
+    {
+        if (cells.size() == m_cells.size()) m_cells = cells;
+    }
+
+    // 格子 (cx, cy) 的世界 AABB
+    CF_Aabb CellAabb(int cx, int cy) const noexcept
+    {
+        CF_Aabb a{};
+        a.min = cf_v2(m_origin.x + cx * m_tile_size, m_origin.y + cy * m_tile_size);
+        a.max = cf_v2(a.min.x + m_tile_size, a.min.y + m_tile_size);
+        return a;
+    }
+
+    // 遍历与 box 重叠的所有实体格子：fn(cx, cy, cell_aabb)
+    template <typename Fn>
+    void ForEachSolidCell(const CF_Aabb& box, Fn&& fn) const noexcept
+    {
+        const int x0 = std::max(0, CellCoord(box.min.x - m_origin.x));
+        const int y0 = std::max(0, CellCoord(box.min.y - m_origin.y));
+        const int x1 = std::min(m_cols - 1, CellCoord(box.max.x - m_origin.x));
+        const int y1 = std::min(m_rows - 1, CellCoord(box.max.y - m_origin.y));
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                if (m_cells[Index(cx, cy)] != kEmpty) fn(cx, cy, CellAabb(cx, cy));
+            }
+        }
+    }
+
+    // 形状与图层的 narrowphase：与所有重叠的实体格子做 cf_collide，返回穿透最深的一个格子的 manifold
+    // （法线由 shape 指向格子，与 cf_collide(shape, cell) 的约定一致）
+    bool CollideShape(const CF_ShapeWrapper& shape, CF_Manifold* out) const noexcept;
+
+    // 线段 from -> to 与实体格子的首个交点：按格子逐个步进（DDA），只访问线段经过的格子。
+    // 命中时写入交点在线段上的比例（0..1，起点位于实体格子内时为 0）
+    bool RayCast(CF_V2 from, CF_V2 to, float* fraction) const noexcept;
+
+    const TileLayer* as_tile_layer() const noexcept override { return this; }
+
+    // 调色板 sprite（由 DrawingSequence 按格子批量绘制）
+    const std::vector<CF_Sprite>& PaletteSprites() const noexcept { return m_palette; }
+
+private:
+    bool InRange(int cx, int cy) const noexcept { return cx >= 0 && cy >= 0 && cx < m_cols && cy < m_rows; }
+    size_t Index(int cx, int cy) const noexcept { return static_cast<size_t>(cy) * static_cast<size_t>(m_cols) + static_cast<size_t>(cx); }
+    int CellCoord(float local) const noexcept { return static_cast<int>(std::floor(local / m_tile_size)); }
+
+    CF_V2 m_origin{ 0.0f, 0.0f };
+    int m_cols = 0;
+    int m_rows = 0;
+    float m_tile_size = 36.0f;
+    std::vector<std::string> m_palette_paths;
+    std::vector<CF_Sprite> m_palette;
+    std::vector<int16_t> m_cells;
+};
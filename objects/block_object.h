@@ -1,6 +1,9 @@
 #pragma once
 #include "base_object.h"
+#include "tile_layer.h"
 #include <iostream>
+#include <string>
+#include <vector>
 
 class BlockObject : public BaseObject {
 public:
@@ -9,6 +12,7 @@ public:
 
     void Start() override
     {
+        SetCollisionLayer(CollisionLayer::Terrain);
         // 设置精灵属性
         if (with_grass){
             SpriteSetSource("/sprites/block1.png", 1);
@@ -25,8 +29,30 @@ public:
         
         // 设置为实体碰撞类型
         SetColliderType(ColliderType::SOLID);
+        SetStatic(true); // 地形不会移动，进入静态碰撞层
     }
 private:
 	CF_V2 target_position{ 0.0f, 0.0f };
     bool with_grass = false;
-};
\ No newline at end of file
+};
+
+// 地形图块：TileLayer 调色板中的 sprite 索引
+enum TerrainTile : int {
+    kTileGrass = 0, // block1.png（带草）
+    kTilePlain = 1, // block2.png
+    kTileDia = 2    // diablock.png
+};
+
+inline std::vector<std::string> TerrainTilePalette()
+{
+    return { "/sprites/block1.png", "/sprites/block2.png", "/sprites/diablock.png" };
+}
+
+// 在地形图层上放置一个方块（pos 为方块左下角，与 BlockObject 一致）；
+// 位置未对齐网格或超出图层范围时退回创建独立的 BlockObject
+inline void PlaceBlock(TileLayer& tiles, CF_V2 pos, bool grass)
+{
+    if (!tiles.SetTileAt(pos, grass ? kTileGrass : kTilePlain)) {
+        objs.Create<BlockObject>(pos, grass);
+    }
+}
@@ -11,9 +11,11 @@ class Blood : public BaseObject {
 	~Blood() noexcept override {}
 	void Start() override
 	{
+		SetCollisionLayer(CollisionLayer::Effect);
 		SpriteSetStats("/sprites/blood.png", 1, 1, 0);
 		IsColliderRotate(false);
 		ExcludeWithSolids(true);
+		SetSolidResolveMode(SolidResolveMode::Analytic);
 		Scale(0.5f);
 	}
 	void Update() override
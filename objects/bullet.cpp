@@ -9,6 +9,7 @@ int Bullet::kLifetimeFrames = g_frame_rate * 5;
 
 void Bullet::Start()
 {
+    SetCollisionLayer(CollisionLayer::Projectile);
     // 记录生成时的全局帧计数
     m_spawn_frame = static_cast<int>(g_frame_count.load());
     // 设置子弹贴图源，其他参数使用默认值
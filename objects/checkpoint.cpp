@@ -5,12 +5,14 @@ extern int g_frame_rate; // ȫ
 
 void Checkpoint::Start()
 {
+    SetCollisionLayer(CollisionLayer::Trigger);
     // Ѷŵλ
     SetPosition(position);
 
 	// þԴ̬ͼ
      SpriteSetStats("/sprites/Save_red.png", 1, 1, -1);
      SetPivot(0, -1); // ײΪ
+     SetStatic(true); // 浵㲻ƶ
 
      turning_green.add(
          static_cast<int>(0.5f * g_frame_rate),
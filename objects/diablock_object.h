@@ -1,5 +1,6 @@
 #pragma once
 #include "base_object.h"
+#include "block_object.h"
 #include <iostream>
 
 class DiaBlockObject : public BaseObject {
@@ -9,6 +10,7 @@ public:
 
     void Start() override
     {
+            SetCollisionLayer(CollisionLayer::Terrain);
         
             SpriteSetSource("/sprites/diablock.png", 1);
         
@@ -21,7 +23,16 @@ public:
 
         // Ϊʵײ
         SetColliderType(ColliderType::SOLID);
+        SetStatic(true); // βƶ뾲̬ײ
     }
 private:
     CF_V2 target_position{ 0.0f, 0.0f };
-};
\ No newline at end of file
+};
+
+// ڵͼϷһη飬δʱ˻ش DiaBlockObject
+inline void PlaceDiaBlock(TileLayer& tiles, CF_V2 pos)
+{
+    if (!tiles.SetTileAt(pos, kTileDia)) {
+        objs.Create<DiaBlockObject>(pos);
+    }
+}
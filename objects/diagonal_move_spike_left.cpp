@@ -6,6 +6,7 @@
 extern int g_frame_rate; // ȫ֡ʣÿ֡
 
 void DiogonalLefMoveSpike::Start() {
+    SetCollisionLayer(CollisionLayer::Hazard);
     // þԴͳʼ״̬
     CF_V2 pos = initial_position;
     SpriteSetStats("/sprites/Obj_Spike.png", 1, 1, 0);
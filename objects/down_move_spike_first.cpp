@@ -4,6 +4,7 @@
 extern int g_frame_rate; // ȫ֡ʣÿ֡
 
 void FirstDownMoveSpike::Start() {
+	SetCollisionLayer(CollisionLayer::Hazard);
 
 	//ת̵ķ
 	SpriteFlipY(true);
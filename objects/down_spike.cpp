@@ -3,6 +3,7 @@
 
 void DownSpike::Start()
 {
+    SetCollisionLayer(CollisionLayer::Hazard);
     //ת̵ķ
     SpriteFlipY(true);
     SpriteSetSource("/sprites/Obj_Spike.png", 1);
@@ -17,6 +18,7 @@ void DownSpike::Start()
     };
 
     SetCenteredPoly(vertices);
+    SetStatic(true); // ̶Ĵ̣뾲̬ײ
 }
 
 void DownSpike::OnCollisionStay(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept {
@@ -3,6 +3,7 @@
 
 void HiddenBlock::Start()
 {
+    SetCollisionLayer(CollisionLayer::Terrain);
     // þ
 
     SpriteSetSource("/sprites/transparent_block_.png", 1);
@@ -17,6 +18,7 @@ void HiddenBlock::Start()
 
     // Ϊʵײ
     SetColliderType(ColliderType::SOLID);
+    SetStatic(true); // βƶ뾲̬ײ
 }
 
 static auto& g = GlobalPlayer::Instance();
@@ -27,6 +29,6 @@ void HiddenBlock::OnCollisionEnter(const ObjManager::ObjToken& other, const CF_M
         SpriteSetSource("/sprites/block1.png", 1);
         SetPivot(-1.0f, -1.0f);
 		once = false;
-        OUTPUT("Hit");
+        LOG_TRACE(General, "Hit");
     }
 }
\ No newline at end of file
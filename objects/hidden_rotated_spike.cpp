@@ -7,6 +7,7 @@ extern int g_frame_rate; // 全局帧率，每秒帧数
 
 void HiddenRotatedSpike::Start()
 {
+    SetCollisionLayer(CollisionLayer::Hazard);
     // 设置默认精灵资源
     SpriteSetSource("/sprites/Obj_Spike.png", 1);
 	SetDepth(-10); // 确保刺被方块遮挡
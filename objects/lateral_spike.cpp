@@ -3,6 +3,7 @@
 
 void LeftLateralSpike::Start()
 {
+    SetCollisionLayer(CollisionLayer::Hazard);
     const double pi = 3.14159265358979323846;
 
     //ת̵ķ
@@ -18,10 +19,12 @@ void LeftLateralSpike::Start()
     };
 
     SetCenteredPoly(vertices);
+    SetStatic(true); // ̶Ĵ̣뾲̬ײ
 }
 
 void RightLateralSpike::Start()
 {
+    SetCollisionLayer(CollisionLayer::Hazard);
     const double pi = 3.14159265358979323846;
 
     //ת̵ķ
@@ -39,6 +42,7 @@ void RightLateralSpike::Start()
     };
 
     SetCenteredPoly(vertices);
+    SetStatic(true); // ̶Ĵ̣뾲̬ײ
 }
 
 void RightLateralSpike::OnCollisionStay(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept {
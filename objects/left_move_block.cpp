@@ -6,6 +6,7 @@
 extern int g_frame_rate;
 
 void LeftMoveBlock::Start() {
+    SetCollisionLayer(CollisionLayer::Terrain);
     //ͼƬ
     SpriteSetStats("/sprites/block1.png", 1, 1, 0);
     SetPosition(initial_position);
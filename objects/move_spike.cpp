@@ -3,6 +3,7 @@
 extern int g_frame_rate; // ȫ֡ʣÿ֡
 
 void MoveSpike::Start() {
+	SetCollisionLayer(CollisionLayer::Hazard);
 	// þԴʼ״̬
 	SpriteSetStats("/sprites/Obj_Spike.png", 1, 1, 0);
 	SetPosition(cf_v2(300.0f, 0.0f)); // ʼλ
@@ -18,10 +18,14 @@ static constexpr float jump_buffer_window = 0.1f; // 跳跃预输入窗口（秒
 
 void PlayerObject::Start()
 {
-    // 统一设置贴图路径、竖排帧数、动画更新频率和绘制深度，并注册到绘制序列
-    // 如需要默认值，请使用高粒度的 SetSprite*() 和 Set*() 方法逐一设置非默认值参数
-    // 资源路径无默认值，必须手动设置
-    SpriteSetStats("/sprites/idle.png", 3, 6, 0);
+    SetCollisionLayer(CollisionLayer::Player);
+    // 一次性登记各状态的动画片段（路径、竖排帧数、动画更新频率），之后只按片段 id 切换
+    clip_idle_ = AddAnimClip("idle", "/sprites/idle.png", 3, 6);
+    clip_walk_ = AddAnimClip("walk", "/sprites/walk.png", 2, 5);
+    clip_jump_ = AddAnimClip("jump", "/sprites/jump.png", 2, 4);
+    clip_fall_ = AddAnimClip("fall", "/sprites/fall.png", 2, 4);
+    PlayAnimClip(clip_idle_);
+    SetDepth(0);
 
 
     // 可选：初始化位置（根据需要调整），例如屏幕中心附近
@@ -30,6 +34,7 @@ void PlayerObject::Start()
     Scale(0.5f);
 	AddTag("player");
 	ExcludeWithSolids(true);
+	SetSolidResolveMode(SolidResolveMode::Analytic); // 解析求解与实体的排斥
     SetCenteredAabb(18.0f, SpriteHeight() / 2); // 设置以贴图中心为基准的碰撞 AABB
     IsColliderRotate(false);
 
@@ -121,22 +126,12 @@ void PlayerObject::EndFrame() {
     auto vel = GetVelocity();
     if (vel.x != 0) SpriteFlipX(vel.x < 0);
 
-    // 根据状态切换贴图
+    // 根据状态切换动画片段（片段未变化时为空操作）
     if (grounded) {
-        if (vel.x != 0) {
-            SpriteSetStats("/sprites/walk.png", 2, 5, 0, false);
-        }
-        else {
-            SpriteSetStats("/sprites/idle.png", 3, 6, 0, false);
-        }
+        PlayAnimClip(vel.x != 0 ? clip_walk_ : clip_idle_);
     }
     else {
-        if (vel.y > 0) {
-            SpriteSetStats("/sprites/jump.png", 2, 4, 0, false);
-        }
-        else {
-            SpriteSetStats("/sprites/fall.png", 2, 4, 0, false);
-        }
+        PlayAnimClip(vel.y > 0 ? clip_jump_ : clip_fall_);
     }
 }
 
@@ -198,7 +193,7 @@ void Tester::Update()
     if (Input::IsKeyInState(CF_KEY_M, KeyState::Hold) &&
         Input::IsKeyInState(CF_KEY_N, KeyState::Hold) &&
         Input::IsKeyInState(CF_KEY_B, KeyState::Down)) {
-        OUTPUT({ "Tester" }, "Test: DestroyAll");
+        LOG_INFO(Player, { "Tester" }, "Test: DestroyAll");
         objs.DestroyAll();
     }
 }
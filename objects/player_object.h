@@ -21,6 +21,11 @@ public:
 private:
 	bool grounded = false;
 	bool double_jump_ready = true;
+	// 动画片段 id（在 Start 中登记）
+	int clip_idle_ = -1;
+	int clip_walk_ = -1;
+	int clip_jump_ = -1;
+	int clip_fall_ = -1;
 	// 记录上一个checkpoint（或默认复活点) 的位置，用于玩家复活/传送使用
 	// -当前向量为默认位置：
 	CF_V2 respawn_point;
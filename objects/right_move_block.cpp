@@ -6,6 +6,7 @@
 extern int g_frame_rate;
 
 void RightMoveBlock::Start() {
+   SetCollisionLayer(CollisionLayer::Terrain);
    //图片设置
     SpriteSetStats("/sprites/block1.png", 1, 1, 0);
     SetPosition(initial_position);
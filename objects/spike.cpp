@@ -3,6 +3,7 @@
 
 void Spike::Start()
 {
+    SetCollisionLayer(CollisionLayer::Hazard);
     // 设置默认精灵资源
     SpriteSetSource("/sprites/Obj_Spike.png", 1);
 
@@ -19,6 +20,7 @@ void Spike::Start()
     };
 
     SetCenteredPoly(vertices);
+    SetStatic(true); // 固定的刺，进入静态碰撞层
 }
 
 void Spike::OnCollisionStay(const ObjManager::ObjToken& other, const CF_Manifold& manifold) noexcept {
@@ -4,6 +4,7 @@
 extern int g_frame_rate; // ȫ֡ʣÿ֡
 
 void UpMoveSpike::Start() {
+	SetCollisionLayer(CollisionLayer::Hazard);
 
 	// þԴʼ״̬
 	SpriteSetStats("/sprites/Obj_Spike.png", 1, 1, 0);
@@ -18,13 +18,14 @@
 #include "diagonal_move_spike_left.h"
 #include "diablock_object.h"
 #include "lateral_spike.h"
+#include "tile_layer.h"
 
 //x为横坐标值
 //starty 为起始值y值
 //endy 为结束y值
 // 为物块种类
-//该函数用于构建连续方块
-void CreateObject(int x, int starty,int endy,int sort) 
+//该函数用于构建连续方块（写入地形图层）
+void CreateObject(TileLayer& tiles, int x, int starty,int endy,int sort) 
 {
 	float hh = 12 * 36.0f;
 	float hw = 16 * 36.0f;
@@ -35,7 +36,7 @@ void CreateObject(int x, int starty,int endy,int sort)
 	{
 		for (float y = -hh + starty * 36.0f; y <= -hh + endy * 36.0f; y += 36.0f)
 		{
-			objs.Create<BlockObject>(cf_v2(-hw + x * 36.0f, y),false);
+			PlaceBlock(tiles, cf_v2(-hw + x * 36.0f, y),false);
 		}
 		break;
 	}
@@ -44,102 +45,53 @@ void CreateObject(int x, int starty,int endy,int sort)
 	{
 		for (float y = -hh + starty * 36.0f; y <= -hh + endy * 36.0f; y += 36.0f)
 		{
-			objs.Create<DiaBlockObject>(cf_v2(-hw +  x * 36.0f, y));
+			PlaceDiaBlock(tiles, cf_v2(-hw +  x * 36.0f, y));
 		}
 		break;
 	}
 	}
 
-	OUTPUT({ "Block Create" }, hh);
+	LOG_TRACE(Room, { "Block Create" }, hh);
 }
 
-void CreateVerticalSpike(int x, int starty, int endy, int sort = 1)
+// 按种类批量创建刺（1 朝上，2 朝下，3 朝右，4 朝左）
+void CreateSpikeBatch(const std::vector<CF_V2>& positions, int sort)
 {
-	float hh = 12 * 36.0f;
-	float hw = (16 - 0.5) * 36.0f;
-
 	switch (sort)
 	{
-	case 1:
-	{
-		for (float y = -hh + starty * 36.0f; y <= -hh + endy * 36.0f; y += 36.0f)
-		{
-			objs.Create<Spike>(CF_V2(-hw + x * 36.0f, y));
-		}
-		break;
+	case 1: objs.CreateBatch<Spike>(positions); break;
+	case 2: objs.CreateBatch<DownSpike>(positions); break;
+	case 3: objs.CreateBatch<RightLateralSpike>(positions); break;
+	case 4: objs.CreateBatch<LeftLateralSpike>(positions); break;
 	}
-	case 2:
-	{
-		for (float y = -hh + starty * 36.0f; y <= -hh + endy * 36.0f; y += 36.0f)
-		{
-			objs.Create<DownSpike>(CF_V2(-hw + x * 36.0f, y));
-		}
-		break;
+}
 
-	}
-	case 3:
-	{
-		for (float y = -hh + starty * 36.0f; y <= -hh + endy * 36.0f; y += 36.0f)
-		{
-			objs.Create<RightLateralSpike>(cf_v2(-hw + x * 36.0f, y));
-		}
-		break;
+void CreateVerticalSpike(int x, int starty, int endy, int sort = 1)
+{
+	float hh = 12 * 36.0f;
+	float hw = (16 - 0.5) * 36.0f;
 
-	}
-	case 4:
+	std::vector<CF_V2> positions;
+	for (float y = -hh + starty * 36.0f; y <= -hh + endy * 36.0f; y += 36.0f)
 	{
-		for (float y = -hh + starty * 36.0f; y <= -hh + endy * 36.0f; y += 36.0f)
-		{
-			objs.Create<LeftLateralSpike>(cf_v2(-hw + x * 36.0f, y));
-		}
-		break;
-	}
+		positions.push_back(cf_v2(-hw + x * 36.0f, y));
 	}
+	CreateSpikeBatch(positions, sort);
 }
 
 void CreateHorizonalSpike(int y,int startx,int endx,int sort = 1)
 {
 	float hh = 12 * 36.0f;
 	float hw = (16 - 0.5) * 36.0f;
-	switch (sort)
-	{
-	case 1:
-	{
-		for (int x = -hw + startx * 36.0f; x < -hw + endx * 36.0f; x += 36.0f)
-		{
-			objs.Create<Spike>(CF_V2(x, -hh + y * 36.0f));
-		}
-		break;
-
-	}
-	case 2:
-	{
-		for (int x = -hw + startx * 36.0f; x <= -hw + endx * 36.0f; x += 36.0f)
-		{
-			objs.Create<DownSpike>(CF_V2(x, -hh + y * 36.0f));
-		}
-		break;
 
-	}
-	case 3:
+	// 只有朝下的刺包含终点
+	const bool inclusive = (sort == 2);
+	std::vector<CF_V2> positions;
+	for (int x = -hw + startx * 36.0f; inclusive ? x <= -hw + endx * 36.0f : x < -hw + endx * 36.0f; x += 36.0f)
 	{
-		for (int x = -hw + startx * 36.0f; x < -hw + endx * 36.0f; x += 36.0f)
-		{
-			objs.Create<RightLateralSpike>(CF_V2(x, -hh + y * 36.0f));
-		}
-		break;
-
-	}
-	case 4:
-	{
-		for (int x = -hw + startx * 36.0f; x < -hw + endx * 36.0f; x += 36.0f)
-		{
-			objs.Create<LeftLateralSpike>(CF_V2(x, -hh + y * 36.0f));
-		}
-		break;
-
-	}
+		positions.push_back(CF_V2(x, -hh + y * 36.0f));
 	}
+	CreateSpikeBatch(positions, sort);
 }
 
 class EmptyRoom : public BaseRoom {
@@ -147,8 +99,11 @@ public:
 	EmptyRoom() noexcept {}
 	~EmptyRoom() noexcept override {}
 
+	// 房间里有大量斜向往返的移动刺与成排的静态刺：移动刺在胖包围盒内移动时不更新树，静态刺不互相比较
+	BroadphaseType Broadphase() const noexcept override { return BroadphaseType::DynamicTree; }
+
 	void RoomLoad() override {
-		OUTPUT({ "EmptyRoom" }, "RoomLoad called.");
+		LOG_INFO(Room, { "EmptyRoom" }, "RoomLoad called.");
 
 		auto& objs = ObjManager::Instance();
 		auto& g_player = GlobalPlayer::Instance();
@@ -170,89 +125,91 @@ public:
 		if (!g_player.HasRespawnRecord())g_player.SetRespawnPoint(cf_v2(-hw + 36 * 1.5f, -hh + 36 * 2));
 		g_player.Emerge();
 
-		//方块系统
+		//方块系统：网格对齐的静止方块写入同一个地形图层
+		auto tiles_token = objs.Create<TileLayer>(cf_v2(-hw, -hh), 32, 24, 36.0f, TerrainTilePalette());
+		TileLayer& tiles = static_cast<TileLayer&>(objs[tiles_token]);
 		
 		//静止系统!!!加静止方块时注意要考虑true和false;
 		
 		//第一行的方块
 		for(float x = -hw; x < hw; x += 36.0f)
 		{
-			objs.Create<BlockObject>(cf_v2(x,hh - 36.0f),false);
+			PlaceBlock(tiles, cf_v2(x,hh - 36.0f),false);
 		}
 
 		//第一列下方的方块
-		objs.Create<BlockObject>(cf_v2(-hw, -hh), false);
+		PlaceBlock(tiles, cf_v2(-hw, -hh), false);
 		for (float y = -hh + 144.0f; y < hh - 7 * 36; y += 72) {
-			objs.Create<BlockObject>(cf_v2(-hw, y), false);
+			PlaceBlock(tiles, cf_v2(-hw, y), false);
 		}
-		objs.Create<BlockObject>(cf_v2(-hw, hh - 5 * 36.0f), false);
-		objs.Create<BlockObject>(cf_v2(-hw + 36.0f, hh - 5 * 36.0f), false);
+		PlaceBlock(tiles, cf_v2(-hw, hh - 5 * 36.0f), false);
+		PlaceBlock(tiles, cf_v2(-hw + 36.0f, hh - 5 * 36.0f), false);
 
 		//第二列的方块
-		objs.Create<BlockObject>(cf_v2(-hw + 36.0f, -hh),true);
+		PlaceBlock(tiles, cf_v2(-hw + 36.0f, -hh),true);
 		
 		//第三列下方的方块
-		objs.Create<BlockObject>(cf_v2(-hw + 72, -hh), false);
+		PlaceBlock(tiles, cf_v2(-hw + 72, -hh), false);
 		for (float y = -hh + 144.0f; y < hh - 6 * 36; y += 72) {
-			objs.Create<BlockObject>(cf_v2(-hw + 72, y), false);
+			PlaceBlock(tiles, cf_v2(-hw + 72, y), false);
 		}
 
 		//第五列的方块
-		objs.Create<DiaBlockObject>(cf_v2(-hw + 4 * 36.0f, -hh + 5 * 36.0f));
+		PlaceDiaBlock(tiles, cf_v2(-hw + 4 * 36.0f, -hh + 5 * 36.0f));
 		
 		//第九列方块
-		CreateObject(8, 2, 6, 2);
+		CreateObject(tiles, 8, 2, 6, 2);
 
 		//第十列方块
-		CreateObject(9, 4, 4, 2);
+		CreateObject(tiles, 9, 4, 4, 2);
 
 		//第十一列方块
-		CreateObject(10, 2, 6, 2);
+		CreateObject(tiles, 10, 2, 6, 2);
 
 		//第十三列方块
-		CreateObject(13, 2, 6, 2);
+		CreateObject(tiles, 13, 2, 6, 2);
 
 		//第十五列方块
-		CreateObject(14, 3, 5, 2);
+		CreateObject(tiles, 14, 3, 5, 2);
 
 		//第十六列方块
-		CreateObject(15, 2, 2, 2);
-		CreateObject(15, 6, 6, 2);
+		CreateObject(tiles, 15, 2, 2, 2);
+		CreateObject(tiles, 15, 6, 6, 2);
 
 		//第十十九列方块
-		CreateObject(18, 2, 6, 2);
+		CreateObject(tiles, 18, 2, 6, 2);
 
 		//第二十列方块
-		CreateObject(19, 2, 2, 2);
+		CreateObject(tiles, 19, 2, 2, 2);
 
 		//第二十一列方块
-		CreateObject(20, 2, 2, 2);
+		CreateObject(tiles, 20, 2, 2, 2);
 
 		//第二十四列方块
-		CreateObject(23, 2, 2, 2);
-		CreateObject(23, 4, 6, 2);
+		CreateObject(tiles, 23, 2, 2, 2);
+		CreateObject(tiles, 23, 4, 6, 2);
 
 		//第二十六列方块
-		CreateObject(25, 2, 2, 2);
-		CreateObject(25, 4, 6, 2);
+		CreateObject(tiles, 25, 2, 2, 2);
+		CreateObject(tiles, 25, 4, 6, 2);
 
 		//第二十八列方块
-		CreateObject(27, 2, 2, 2);
-		CreateObject(27, 4, 6, 2);
+		CreateObject(tiles, 27, 2, 2, 2);
+		CreateObject(tiles, 27, 4, 6, 2);
 
 		//第三十一列方块
-		CreateObject(30, 14, 14,2);
-		CreateObject(30, 2, 3, 2);
+		CreateObject(tiles, 30, 14, 14,2);
+		CreateObject(tiles, 30, 2, 3, 2);
 		
 		//第三十二列方块
-		CreateObject(31, 2, 2, 2);
+		CreateObject(tiles, 31, 2, 2, 2);
 
 		//第三十三列放块
-		CreateObject(32, 6, 22, 1);
+		CreateObject(tiles, 32, 6, 22, 1);
 
 		//最后一列的方块
 		{
-			objs.Create<BlockObject>(cf_v2(hw - 36.0f, 2 * 36.0f),false);
+			PlaceBlock(tiles, cf_v2(hw - 36.0f, 2 * 36.0f),false);
 		}
 		//移动方块
 
@@ -363,7 +320,7 @@ public:
 		}
 	}
 	void RoomUnload() override {
-		OUTPUT({ "TestRoom" }, "RoomUnload called.");
+		LOG_INFO(Room, { "TestRoom" }, "RoomUnload called.");
 	}
 };
 
@@ -16,7 +16,7 @@ public:
 
 	// ӷ߼
 	void RoomLoad() override {
-		OUTPUT({ "EndRoom" }, "RoomLoad called.");
+		LOG_INFO(Room, { "EndRoom" }, "RoomLoad called.");
 
 		auto& g = GlobalPlayer::Instance();
 		float hw = DrawUI::half_w;
@@ -49,7 +49,7 @@ public:
 
 	// ӷж߼
 	void RoomUnload() override {
-		OUTPUT({ "EndRoom" }, "RoomUnload called.");
+		LOG_INFO(Room, { "EndRoom" }, "RoomUnload called.");
 
 	}
 };
@@ -23,7 +23,7 @@ public:
 
 	// 在这里添加房间加载逻辑
 	void RoomLoad() override {
-		OUTPUT({ "FirstRoom" }, "RoomLoad called.");
+		LOG_INFO(Room, { "FirstRoom" }, "RoomLoad called.");
 
 		auto& g = GlobalPlayer::Instance();
 		float hw = DrawUI::half_w;
@@ -35,18 +35,21 @@ public:
 		if (!g.HasRespawnRecord())g.SetRespawnPoint(cf_v2(-hw + 36 * 2, -hh + 36 * 2));
 		g.Emerge();
 
+		// 四周的墙一次性批量创建
+		std::vector<std::tuple<CF_V2, bool>> walls;
 		for (float y = -hh; y < hh; y += 36) {
-			objs.Create<BlockObject>(cf_v2(-hw, y), false);
+			walls.emplace_back(cf_v2(-hw, y), false);
 		}
 		for (float y = -hh + 36 * 4; y < hh ; y += 36) {
-			objs.Create<BlockObject>(cf_v2(hw - 36.0f, y), false);
+			walls.emplace_back(cf_v2(hw - 36.0f, y), false);
 		}
 		for (float x = -hw + 36; x < hw - 36 ; x += 36) {
-			objs.Create<BlockObject>(cf_v2(x, hh - 36.0f), false);
+			walls.emplace_back(cf_v2(x, hh - 36.0f), false);
 		}
 		for (float x = -hw + 36; x < hw - 36; x += 36) {
-			objs.Create<BlockObject>(cf_v2(x, -hh), true);
+			walls.emplace_back(cf_v2(x, -hh), true);
 		}
+		objs.CreateBatch<BlockObject>(walls);
 
 		//手搓地图ing……
 		auto bolck1_token = objs.Create<BlockObject>(cf_v2(-hw + 36 * 4, -hh + 36),false);
@@ -94,7 +97,7 @@ public:
 
 	// 在这里添加房间卸载逻辑
 	void RoomUnload() override {
-		OUTPUT({ "FirstRoom" }, "RoomUnload called.");
+		LOG_INFO(Room, { "FirstRoom" }, "RoomUnload called.");
 
 	}
 };
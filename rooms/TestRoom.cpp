@@ -24,9 +24,12 @@ public:
 	TestRoom() noexcept {}
 	~TestRoom() noexcept override {}
 
+	// 移动刺会被 ActSeq 放大到数个格子大小，网格的 3x3 邻域覆盖不到，改用 X 轴扫描
+	BroadphaseType Broadphase() const noexcept override { return BroadphaseType::SweepAndPrune; }
+
 	// 在这里添加房间加载逻辑
 	void RoomLoad() override {
-		OUTPUT({ "TestRoom" }, "RoomLoad called.");
+		LOG_INFO(Room, { "TestRoom" }, "RoomLoad called.");
 
 		auto& objs = ObjManager::Instance();
 		auto& g_player = GlobalPlayer::Instance();
@@ -79,7 +82,7 @@ public:
 
 	// 在这里添加房间卸载逻辑
 	void RoomUnload() override {
-		OUTPUT({ "TestRoom" }, "RoomUnload called.");
+		LOG_INFO(Room, { "TestRoom" }, "RoomUnload called.");
 
 	}
 };
@@ -7,6 +7,7 @@
 #include "backgroud.h"
 #include "checkpoint.h"
 #include "block_object.h"
+#include "tile_layer.h"
 #include "spike.h"
 #include "lateral_spike.h"
 #include "straight_cherry.h"
@@ -21,7 +22,7 @@ public:
 
 	// ӷ߼
 	void RoomLoad() override {
-		OUTPUT({ "NextRoom" }, "RoomLoad called.");
+		LOG_INFO(Room, { "NextRoom" }, "RoomLoad called.");
 
 		auto& g = GlobalPlayer::Instance();
 		float hw = DrawUI::half_w;
@@ -33,20 +34,24 @@ public:
 		if (!g.HasRespawnRecord())g.SetRespawnPoint(cf_v2(-hw + 36 * 2, -hh + 36 * 2));
 		g.Emerge();
 
+		// ľֹдͬһͼ㣨طȴΪķΪ
+		auto tiles_token = objs.Create<TileLayer>(cf_v2(-hw, -hh), 32, 24, 36.0f, TerrainTilePalette());
+		TileLayer& tiles = static_cast<TileLayer&>(objs[tiles_token]);
+
 		for (float y = -hh + 4 * 36.0f; y < hh; y += 36) {
-			objs.Create<BlockObject>(cf_v2(-hw, y), false);
+			PlaceBlock(tiles, cf_v2(-hw, y), false);
 		}
 		for (float y = -hh; y < hh - 3 * 36.0f; y += 36) {
-			objs.Create<BlockObject>(cf_v2(hw - 36.0f, y), false);
+			PlaceBlock(tiles, cf_v2(hw - 36.0f, y), false);
 		}
 
-		objs.Create<BlockObject>(cf_v2(hw - 36.0f, hh - 36.0f), false);
+		PlaceBlock(tiles, cf_v2(hw - 36.0f, hh - 36.0f), false);
 
 		for (float x = -hw + 36; x < hw - 36; x += 36) {
-			objs.Create<BlockObject>(cf_v2(x, hh - 36.0f), false);
+			PlaceBlock(tiles, cf_v2(x, hh - 36.0f), false);
 		}
 		for (float x = -hw; x < hw - 36; x += 36) {
-			objs.Create<BlockObject>(cf_v2(x, -hh), true);
+			PlaceBlock(tiles, cf_v2(x, -hh), true);
 		}
 
 		//ִͼing
@@ -54,27 +59,9 @@ public:
 		float half = 18.0f;
 
 		// ֮
-		objs.Create<Spike>(cf_v2(-6 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(-5 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(-4 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(-3 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(-2 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(-1 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(0 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(1 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(2 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(3 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(4 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(5 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(6 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(7 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(8 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(9 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(10 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(11 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(12 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(13 * w + half, -11 * w));
-		objs.Create<Spike>(cf_v2(14 * w + half, -11 * w));
+		std::vector<CF_V2> spike_sea;
+		for (int i = -6; i <= 14; ++i) spike_sea.push_back(cf_v2(i * w + half, -11 * w));
+		objs.CreateBatch<Spike>(spike_sea);
 		
 		// 浵
         objs.Create<Checkpoint>(cf_v2(-8 * w + half, -11 * w));
@@ -86,44 +73,44 @@ public:
 		objs.Create<HiddenSpike>(cf_v2(-12 * w + half, -12 * w), 2, true);
 
 		// ʼſ
-		objs.Create<BlockObject>(cf_v2(-15 * w, -9 * w), true);
+		PlaceBlock(tiles, cf_v2(-15 * w, -9 * w), true);
 
 		// ϰ
-		objs.Create<BlockObject>(cf_v2(-14 * w, -6 * w), true);
-		objs.Create<BlockObject>(cf_v2(-13 * w, -6 * w), true);
-		objs.Create<BlockObject>(cf_v2(-12 * w, -7 * w), true);
+		PlaceBlock(tiles, cf_v2(-14 * w, -6 * w), true);
+		PlaceBlock(tiles, cf_v2(-13 * w, -6 * w), true);
+		PlaceBlock(tiles, cf_v2(-12 * w, -7 * w), true);
 		objs.Create<Spike>(cf_v2(-12 * w + half, -5 * w));
 
 		// ̵ŵ
-		objs.Create<BlockObject>(cf_v2(-6 * w, -8 * w), true);
+		PlaceBlock(tiles, cf_v2(-6 * w, -8 * w), true);
 		objs.Create<LeftLateralSpike>(cf_v2(-6 * w, -8 * w + half));
 		objs.Create<RightLateralSpike>(cf_v2(-5 * w, -8 * w + half));
 
 		// ˫ƽ̨
-		objs.Create<BlockObject>(cf_v2(-3 * w, -7 * w), true);
-		objs.Create<BlockObject>(cf_v2(-2 * w, -7 * w),true);
-		objs.Create<BlockObject>(cf_v2(-1 * w, -7 * w),true);
-		objs.Create<BlockObject>(cf_v2(-3 * w, -3 * w), true);
-		objs.Create<BlockObject>(cf_v2(-2 * w, -3 * w), true);
-		objs.Create<BlockObject>(cf_v2(-1 * w, -3 * w), true);
+		PlaceBlock(tiles, cf_v2(-3 * w, -7 * w), true);
+		PlaceBlock(tiles, cf_v2(-2 * w, -7 * w),true);
+		PlaceBlock(tiles, cf_v2(-1 * w, -7 * w),true);
+		PlaceBlock(tiles, cf_v2(-3 * w, -3 * w), true);
+		PlaceBlock(tiles, cf_v2(-2 * w, -3 * w), true);
+		PlaceBlock(tiles, cf_v2(-1 * w, -3 * w), true);
 		objs.Create<HiddenSpike>(cf_v2(-3 * w + half, -2 * w), 3, false);
 		objs.Create<HiddenSpike>(cf_v2(-2 * w + half, -2 * w), 3, false);
 		objs.Create<HiddenSpike>(cf_v2(-1 * w + half, -2 * w), 3, false);
 
 		// ŵ
-		objs.Create<BlockObject>(cf_v2(3 * w + half, -7 * w + half), true);
+		PlaceBlock(tiles, cf_v2(3 * w + half, -7 * w + half), true);
 
 		// ӵ
-		objs.Create<BlockObject>(cf_v2(6 * w, -6 * w), true);
-		objs.Create<BlockObject>(cf_v2(7 * w, -6 * w), true);
-		objs.Create<BlockObject>(cf_v2(8 * w, -6 * w), true);
+		PlaceBlock(tiles, cf_v2(6 * w, -6 * w), true);
+		PlaceBlock(tiles, cf_v2(7 * w, -6 * w), true);
+		PlaceBlock(tiles, cf_v2(8 * w, -6 * w), true);
 		objs.Create<HiddenSpike>(cf_v2(7 * w + half, -6 * w), 2, true);
 		objs.Create<HiddenSpike>(cf_v2(8 * w + half, -6 * w), 2, true);
 
 		// شСƽ̨
-		objs.Create<BlockObject>(cf_v2(10 * w, -4 * w), true);
-		objs.Create<BlockObject>(cf_v2(11 * w, -4 * w), true);
-		objs.Create<BlockObject>(cf_v2(12 * w, -4 * w), true);
+		PlaceBlock(tiles, cf_v2(10 * w, -4 * w), true);
+		PlaceBlock(tiles, cf_v2(11 * w, -4 * w), true);
+		PlaceBlock(tiles, cf_v2(12 * w, -4 * w), true);
 		objs.Create<HiddenSpike>(cf_v2(11 * w + half, -4 * w), 2, true);
 
 		// ƶƻ
@@ -133,40 +120,40 @@ public:
 		objs.Create<StraightCherry>(cf_v2(13 * w + half, 6 * w + half), 6 * w, false);
 
 		// 
-		objs.Create<BlockObject>(cf_v2(8 * w, -1 * w), true);
-		objs.Create<BlockObject>(cf_v2(8 * w, 1 * w), true);
-		objs.Create<BlockObject>(cf_v2(8 * w, 3 * w), true);
-		objs.Create<BlockObject>(cf_v2(8 * w, 5 * w), true);
+		PlaceBlock(tiles, cf_v2(8 * w, -1 * w), true);
+		PlaceBlock(tiles, cf_v2(8 * w, 1 * w), true);
+		PlaceBlock(tiles, cf_v2(8 * w, 3 * w), true);
+		PlaceBlock(tiles, cf_v2(8 * w, 5 * w), true);
 
 		// 
-		objs.Create<BlockObject>(cf_v2(11 * w, 0 * w), true);
-		objs.Create<BlockObject>(cf_v2(11 * w, 2 * w), true);
-		objs.Create<BlockObject>(cf_v2(11 * w, 4 * w), true);
-		objs.Create<BlockObject>(cf_v2(11 * w, 6 * w), true);
+		PlaceBlock(tiles, cf_v2(11 * w, 0 * w), true);
+		PlaceBlock(tiles, cf_v2(11 * w, 2 * w), true);
+		PlaceBlock(tiles, cf_v2(11 * w, 4 * w), true);
+		PlaceBlock(tiles, cf_v2(11 * w, 6 * w), true);
 
 		// 
-		objs.Create<BlockObject>(cf_v2(14 * w, -1 * w), true);
-		objs.Create<BlockObject>(cf_v2(14 * w, 1 * w), true);
-		objs.Create<BlockObject>(cf_v2(14 * w, 3 * w), true);
-		objs.Create<BlockObject>(cf_v2(14 * w, 5 * w), true);
+		PlaceBlock(tiles, cf_v2(14 * w, -1 * w), true);
+		PlaceBlock(tiles, cf_v2(14 * w, 1 * w), true);
+		PlaceBlock(tiles, cf_v2(14 * w, 3 * w), true);
+		PlaceBlock(tiles, cf_v2(14 * w, 5 * w), true);
 
 		// ƽ̨
-		objs.Create<BlockObject>(cf_v2(5 * w, 5 * w), true);
-		objs.Create<BlockObject>(cf_v2(6 * w, 5 * w), true);
-		objs.Create<BlockObject>(cf_v2(7 * w, 5 * w), true);
+		PlaceBlock(tiles, cf_v2(5 * w, 5 * w), true);
+		PlaceBlock(tiles, cf_v2(6 * w, 5 * w), true);
+		PlaceBlock(tiles, cf_v2(7 * w, 5 * w), true);
 
 		// ڡ೤ƽ̨
-		objs.Create<BlockObject>(cf_v2(5 * w, 8 * w), true);
-		objs.Create<BlockObject>(cf_v2(6 * w, 8 * w), true);
-		objs.Create<BlockObject>(cf_v2(7 * w, 8 * w), true);
-		objs.Create<BlockObject>(cf_v2(8 * w, 8 * w), true);
-		objs.Create<BlockObject>(cf_v2(9 * w, 8 * w), true);
-		objs.Create<BlockObject>(cf_v2(10 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(5 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(6 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(7 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(8 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(9 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(10 * w, 8 * w), true);
 
 		// ڡҲƽ̨
-		objs.Create<BlockObject>(cf_v2(12 * w, 8 * w), true);
-		objs.Create<BlockObject>(cf_v2(13 * w, 8 * w), true);
-		objs.Create<BlockObject>(cf_v2(14 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(12 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(13 * w, 8 * w), true);
+		PlaceBlock(tiles, cf_v2(14 * w, 8 * w), true);
         objs.Create<HiddenRotatedSpike>(cf_v2(13 * w, 8 * w + half), 1, true, 2, 0.1f);
 
 		// ط
@@ -176,12 +163,12 @@ public:
 		objs.Create<HiddenBlock>(cf_v2(6 * w, 7 * w));
 
 		// С·
-		objs.Create<BlockObject>(cf_v2(4 * w, 2 * w), true);
-		objs.Create<BlockObject>(cf_v2(5 * w, 2 * w), true);
+		PlaceBlock(tiles, cf_v2(4 * w, 2 * w), true);
+		PlaceBlock(tiles, cf_v2(5 * w, 2 * w), true);
 		objs.Create<HiddenSpike>(cf_v2(5 * w + half, 2 * w), 2, true);
 
 		// 
-		objs.Create<BlockObject>(cf_v2(0 * w, 4 * w), true);
+		PlaceBlock(tiles, cf_v2(0 * w, 4 * w), true);
 
 		// Ϸؿ
 		objs.Create<HiddenBlock>(cf_v2(0 * w, 7 * w));
@@ -235,7 +222,7 @@ public:
 
 	// ӷж߼
 	void RoomUnload() override {
-		OUTPUT({ "NextRoom" }, "RoomUnload called.");
+		LOG_INFO(Room, { "NextRoom" }, "RoomUnload called.");
 
 	}
 };
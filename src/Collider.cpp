@@ -1,7 +1,9 @@
 #include "base_physics.h"
 #include "base_object.h"
+#include "tile_layer.h"
 #include "debug_config.h"
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <sstream> // 用于构建复杂字符串
 #include <unordered_map>
@@ -12,14 +14,14 @@
 static void dump_shape_world(const CF_ShapeWrapper& s) noexcept {
 	switch (s.type) {
 	case CF_SHAPE_TYPE_AABB:
-		OUTPUT({"Physics"}, "    AABB min=(", s.u.aabb.min.x, ",", s.u.aabb.min.y, ")",
+		LOG_TRACE(Physics, "    AABB min=(", s.u.aabb.min.x, ",", s.u.aabb.min.y, ")",
 			" max=(", s.u.aabb.max.x, ",", s.u.aabb.max.y, ")");
 		break;
 	case CF_SHAPE_TYPE_CIRCLE:
-		OUTPUT({"Physics"}, "    CIRCLE p=(", s.u.circle.p.x, ",", s.u.circle.p.y, ") r=", s.u.circle.r);
+		LOG_TRACE(Physics, "    CIRCLE p=(", s.u.circle.p.x, ",", s.u.circle.p.y, ") r=", s.u.circle.r);
 		break;
 	case CF_SHAPE_TYPE_CAPSULE:
-		OUTPUT({"Physics"}, "    CAPSULE a=(", s.u.capsule.a.x, ",", s.u.capsule.a.y, ")",
+		LOG_TRACE(Physics, "    CAPSULE a=(", s.u.capsule.a.x, ",", s.u.capsule.a.y, ")",
 			" b=(", s.u.capsule.b.x, ",", s.u.capsule.b.y, ") r=", s.u.capsule.r);
 		break;
 	case CF_SHAPE_TYPE_POLY:
@@ -29,11 +31,11 @@ static void dump_shape_world(const CF_ShapeWrapper& s) noexcept {
 		for (int i = 0; i < s.u.poly.count; ++i) {
 			ss << " (" << s.u.poly.verts[i].x << "," << s.u.poly.verts[i].y << ")";
 		}
-		OUTPUT({"Physics"}, ss.str());
+		LOG_TRACE(Physics, ss.str());
 	}
 	break;
 	default:
-		OUTPUT({"Physics"}, "    Unknown shape");
+		LOG_TRACE(Physics, "    Unknown shape");
 		break;
 	}
 }
@@ -97,8 +99,8 @@ static CF_ShapeWrapper translate_shape_world(const CF_ShapeWrapper& s, const CF_
 }
 
 // 将 shape 转换为 AABB，用于 broadphase 网格索引或快速剔除
-// - 返回值为该形状在 world-space 下的轴对齐包围盒（用于格子索引）
-static CF_Aabb shape_wrapper_to_aabb(const CF_ShapeWrapper& s) noexcept
+// - 返回值为该形状在 world-space 下的轴对齐包围盒（用于格子索引，TileLayer 也用它确定查询的格子范围）
+CF_Aabb shape_wrapper_to_aabb(const CF_ShapeWrapper& s) noexcept
 {
 	CF_Aabb aabb{};
 	if (s.type == CF_SHAPE_TYPE_AABB) {
@@ -169,6 +171,65 @@ static bool shapes_collide_world(const CF_ShapeWrapper& A, const CF_ShapeWrapper
 	return true;
 }
 
+// AABB-AABB：按两轴重叠量取较浅的一轴作为分离方向，单个接触点位于 a 在该方向上的面中点
+// （与 cute_c2 的 c2AABBtoAABBManifold 相同，因此与 cf_collide 的结果一致；输出已规范，无需再 normalize）
+bool aabb_to_aabb_manifold(const CF_Aabb& a, const CF_Aabb& b, CF_Manifold* out) noexcept
+{
+	const CF_V2 mid_a = (a.min + a.max) * 0.5f;
+	const CF_V2 mid_b = (b.min + b.max) * 0.5f;
+	const float ea_x = std::fabs((a.max.x - a.min.x) * 0.5f);
+	const float ea_y = std::fabs((a.max.y - a.min.y) * 0.5f);
+	const float eb_x = std::fabs((b.max.x - b.min.x) * 0.5f);
+	const float eb_y = std::fabs((b.max.y - b.min.y) * 0.5f);
+	const CF_V2 d = mid_b - mid_a;
+
+	const float dx = ea_x + eb_x - std::fabs(d.x);
+	if (!(dx >= 0.0f)) return false;
+	const float dy = ea_y + eb_y - std::fabs(d.y);
+	if (!(dy >= 0.0f)) return false;
+
+	if (!out) return true;
+	CF_Manifold m{};
+	m.count = 1;
+	if (dx < dy) {
+		m.depths[0] = dx;
+		m.n = cf_v2(d.x < 0.0f ? -1.0f : 1.0f, 0.0f);
+		m.contact_points[0] = mid_a + cf_v2(d.x < 0.0f ? -ea_x : ea_x, 0.0f);
+	}
+	else {
+		m.depths[0] = dy;
+		m.n = cf_v2(0.0f, d.y < 0.0f ? -1.0f : 1.0f);
+		m.contact_points[0] = mid_a + cf_v2(0.0f, d.y < 0.0f ? -ea_y : ea_y);
+	}
+	*out = m;
+	return true;
+}
+
+static bool aabb_vs_aabb_world(const CF_ShapeWrapper& A, const CF_ShapeWrapper& B, CF_Manifold* out_manifold) noexcept
+{
+	return aabb_to_aabb_manifold(A.u.aabb, B.u.aabb, out_manifold);
+}
+
+// narrowphase 分发表：按 (A 类型, B 类型) 选择碰撞函数，没有专用实现的组合走通用的 shapes_collide_world。
+// 房间中绝大多数碰撞体（方块、不旋转的玩家、子弹）都是 AABB，AABB-AABB 直接计算而不经过 cf_collide 的通用路径
+using NarrowphaseFn = bool (*)(const CF_ShapeWrapper&, const CF_ShapeWrapper&, CF_Manifold*) noexcept;
+static constexpr size_t kShapeTypeCount = static_cast<size_t>(CF_SHAPE_TYPE_POLY) + 1;
+
+static const std::array<std::array<NarrowphaseFn, kShapeTypeCount>, kShapeTypeCount> kNarrowphaseTable = [] {
+	std::array<std::array<NarrowphaseFn, kShapeTypeCount>, kShapeTypeCount> table{};
+	for (auto& row : table) row.fill(&shapes_collide_world);
+	table[CF_SHAPE_TYPE_AABB][CF_SHAPE_TYPE_AABB] = &aabb_vs_aabb_world;
+	return table;
+}();
+
+static bool collide_world_dispatch(const CF_ShapeWrapper& A, const CF_ShapeWrapper& B, CF_Manifold* out_manifold) noexcept
+{
+	const size_t ta = static_cast<size_t>(A.type);
+	const size_t tb = static_cast<size_t>(B.type);
+	if (ta >= kShapeTypeCount || tb >= kShapeTypeCount) return shapes_collide_world(A, B, out_manifold);
+	return kNarrowphaseTable[ta][tb](A, B, out_manifold);
+}
+
 static void merge_manifold_contact_points(CF_Manifold& base, const CF_Manifold& other) noexcept
 {
 	if (base.count >= 2 || other.count <= 0) return;
@@ -188,22 +249,77 @@ static void merge_manifold_contact_points(CF_Manifold& base, const CF_Manifold&
 	}
 }
 
+// 从物体的接触列表中移除一个 pair key（列表很短，swap-remove）
+static void erase_pair_key(std::vector<uint64_t>& keys, uint64_t pair_key) noexcept
+{
+	auto it = std::find(keys.begin(), keys.end(), pair_key);
+	if (it == keys.end()) return;
+	*it = keys.back();
+	keys.pop_back();
+}
+
+// 取得 BasePhysics 在 world-space 下的形状：若未启用 world shape，则按 position 平移
+static CF_ShapeWrapper entry_world_shape(const BasePhysics* p) noexcept
+{
+	const CF_ShapeWrapper& s = p->get_shape();
+	if (p->is_world_shape_enabled()) return s;
+	return translate_shape_world(s, p->get_position());
+}
+
 // 注意：PhysicsSystem 通过 ObjToken 管理 BasePhysics 的注册与反注册，从而在 Step() 中统一进行碰撞检测与回调。
 // 以下实现关注性能与稳定性：使用格子 broadphase 降低 narrowphase 次数，合并重复 contact 以限制每对最多两个 contact。
+// 条目分为两层：
+// - 静态层（static_entries_）：显式 set_static 或长时间静止的 SOLID/VOID 物体，网格持久化，仅在集合变化时重建
+// - 动态层（dynamic_entries_）：每帧重新计算 world shape 并重建网格
 void PhysicsSystem::Register(const ObjManager::ObjToken& token, BasePhysics* phys) noexcept
 {
 	if (!phys) return;
 	uint64_t key = make_key(token);
 
+	// TileLayer 单独保存，不进入任何网格
+	if (phys->as_tile_layer()) {
+		for (Entry& t : tile_layers_) {
+			if (make_key(t.token) == key) {
+				t.physics = phys;
+				return;
+			}
+		}
+		Entry e;
+		e.token = token;
+		e.physics = phys;
+		tile_layers_.push_back(e);
+		return;
+	}
+
 	auto it = dynamic_token_map_.find(key);
 	if (it != dynamic_token_map_.end()) {
 		dynamic_entries_[it->second].physics = phys;
 		dynamic_entries_[it->second].token = token;
 		return;
 	}
+	auto sit = static_token_map_.find(key);
+	if (sit != static_token_map_.end()) {
+		static_entries_[sit->second].physics = phys;
+		static_entries_[sit->second].token = token;
+		static_grid_dirty_ = true;
+		return;
+	}
 	Entry e;
 	e.token = token;
 	e.physics = phys;
+	// DynamicTree：注册时立即建立代理，使空间查询在下一次 Step 之前也能找到新条目（tree_refs_ 在 Step 中回写）
+	if (broadphase_ == BroadphaseType::DynamicTree) {
+		e.tree_proxy = tree_.CreateProxy(shape_wrapper_to_aabb(entry_world_shape(phys)), key,
+			phys->is_static() ? 0.0f : kTreeFatMargin);
+	}
+	if (phys->is_static()) {
+		// 静态条目在提交时直接进入静态层，下一次 Step 时一次性构建静态网格
+		e.shape_version = phys->world_shape_version();
+		static_entries_.push_back(e);
+		static_token_map_[key] = static_entries_.size() - 1;
+		static_grid_dirty_ = true;
+		return;
+	}
 	dynamic_entries_.push_back(e);
 	dynamic_token_map_[key] = dynamic_entries_.size() - 1;
 }
@@ -214,10 +330,16 @@ void PhysicsSystem::Unregister(const ObjManager::ObjToken& token) noexcept
 {
 	uint64_t key = make_key(token);
 
+	auto tile_it = std::find_if(tile_layers_.begin(), tile_layers_.end(),
+		[key](const Entry& t) { return make_key(t.token) == key; });
 	auto static_it = static_token_map_.find(key);
-	if (static_it != static_token_map_.end()) {
+	if (tile_it != tile_layers_.end()) {
+		tile_layers_.erase(tile_it);
+	}
+	else if (static_it != static_token_map_.end()) {
 		size_t idx = static_it->second;
 		size_t last = static_entries_.size() - 1;
+		release_tree_proxy(static_entries_[idx]);
 		if (idx != last) {
 			static_entries_[idx] = static_entries_[last];
 			uint64_t moved_key = make_key(static_entries_[idx].token);
@@ -225,12 +347,14 @@ void PhysicsSystem::Unregister(const ObjManager::ObjToken& token) noexcept
 		}
 		static_entries_.pop_back();
 		static_token_map_.erase(static_it);
+		static_grid_dirty_ = true;
 	}
 	else {
 		auto dynamic_it = dynamic_token_map_.find(key);
 		if (dynamic_it == dynamic_token_map_.end()) return;
 		size_t idx = dynamic_it->second;
 		size_t last = dynamic_entries_.size() - 1;
+		release_tree_proxy(dynamic_entries_[idx]);
 		if (idx != last) {
 			dynamic_entries_[idx] = dynamic_entries_[last];
 			uint64_t moved_key = make_key(dynamic_entries_[idx].token);
@@ -240,207 +364,703 @@ void PhysicsSystem::Unregister(const ObjManager::ObjToken& token) noexcept
 		dynamic_token_map_.erase(dynamic_it);
 	}
 
+	// 只移除该物体自己的接触对：在有序的 prev_pairs_ 中二分定位并标记失效（保持数组有序，下一次 Step 时自然丢弃），
+	// 同时从对方的接触列表中摘除，再丢弃自己的列表（不产生 Exit）
+	auto own = body_pairs_.find(key);
+	if (own == body_pairs_.end()) return;
+	for (uint64_t pair_key : own->second) {
+		auto pit = std::lower_bound(prev_pairs_.begin(), prev_pairs_.end(), pair_key,
+			[](const ContactPair& cp, uint64_t k) { return cp.key < k; });
+		if (pit == prev_pairs_.end() || pit->key != pair_key || !pit->alive) continue;
+		pit->alive = false;
+		const uint64_t first = make_key(pit->first);
+		const uint64_t other = first == key ? make_key(pit->second) : first;
+		auto oit = body_pairs_.find(other);
+		if (oit != body_pairs_.end()) erase_pair_key(oit->second, pair_key);
+	}
+	body_pairs_.erase(own);
+}
+
+void PhysicsSystem::link_pair(const ContactPair& cp)
+{
+	body_pairs_[make_key(cp.first)].push_back(cp.key);
+	body_pairs_[make_key(cp.second)].push_back(cp.key);
+}
 
-    // 修复：当对象被销毁时，从碰撞对记录中移除相关条目，防止内存泄漏和性能下降
-    auto clean_pairs = [&](auto& pairs_map) {
-        for (auto it = pairs_map.begin(); it != pairs_map.end(); ) {
-            if (make_key(it->second.first) == key || make_key(it->second.second) == key) {
-                it = pairs_map.erase(it);
-            } else {
-                ++it;
-            }
-        }
-    };
+void PhysicsSystem::unlink_pair(const ContactPair& cp) noexcept
+{
+	for (uint64_t body : { make_key(cp.first), make_key(cp.second) }) {
+		auto it = body_pairs_.find(body);
+		if (it != body_pairs_.end()) erase_pair_key(it->second, cp.key);
+	}
+}
 
-    clean_pairs(prev_collision_pairs_);
-    clean_pairs(current_pairs_);
+void PhysicsSystem::Reserve(size_t dynamic_count, size_t static_count)
+{
+	// 不足时至少翻倍，避免逐帧小批量提交时每次都精确扩容
+	auto grow = [](auto& v, size_t need) {
+		if (need > v.capacity()) v.reserve(std::max(need, v.capacity() * 2));
+	};
+	auto grow_map = [](auto& m, size_t need) {
+		if (static_cast<float>(need) > m.max_load_factor() * static_cast<float>(m.bucket_count()))
+			m.reserve(std::max(need, m.size() * 2));
+	};
+	if (dynamic_count > 0) {
+		grow(dynamic_entries_, dynamic_entries_.size() + dynamic_count);
+		grow_map(dynamic_token_map_, dynamic_token_map_.size() + dynamic_count);
+	}
+	if (static_count > 0) {
+		grow(static_entries_, static_entries_.size() + static_count);
+		grow_map(static_token_map_, static_token_map_.size() + static_count);
+	}
 }
 
-void PhysicsSystem::Step(float cell_size) noexcept
+void PhysicsSystem::UnregisterAll() noexcept
 {
+	// 只清空内容、保留容量，下一个房间注册时无需重新分配
+	dynamic_entries_.clear();
+	dynamic_token_map_.clear();
+	static_entries_.clear();
+	static_token_map_.clear();
+	tile_layers_.clear();
+	static_world_shapes_.clear();
+	static_world_aabbs_.clear();
+	static_grid_dirty_ = true;
 	events_.clear();
-	if (dynamic_entries_.empty() && static_entries_.empty()) return;
+	prev_pairs_.clear();
+	current_pairs_.clear();
+	exit_pairs_.clear();
+	body_pairs_.clear();
+	sap_proxies_.clear();
+	tree_.Clear();
+}
 
-	// 清空上次 frame 使用过的网格 bucket，以便复用容器
-	for (uint64_t k : grid_keys_used_) {
-		auto git = grid_.find(k);
-		if (git != grid_.end()) {
-			git->second.clear();
-		}
+// 动态层 -> 静态层（swap-remove）
+void PhysicsSystem::move_to_static(size_t dynamic_idx) noexcept
+{
+	Entry e = dynamic_entries_[dynamic_idx];
+	uint64_t key = make_key(e.token);
+	size_t last = dynamic_entries_.size() - 1;
+	if (dynamic_idx != last) {
+		dynamic_entries_[dynamic_idx] = dynamic_entries_[last];
+		dynamic_token_map_[make_key(dynamic_entries_[dynamic_idx].token)] = dynamic_idx;
 	}
-	grid_keys_used_.clear();
+	dynamic_entries_.pop_back();
+	dynamic_token_map_.erase(key);
 
-	// 调整 world_shapes_ 大小以容纳所有对象
-	world_shapes_.resize(dynamic_entries_.size() + static_entries_.size());
+	e.rest_frames = 0;
+	static_entries_.push_back(e);
+	static_token_map_[key] = static_entries_.size() - 1;
+	static_grid_dirty_ = true;
+}
 
-	// 辅助函数：将对象更新并放入网格
-	auto update_entry_in_grid = [&](Entry& entry, size_t world_shape_idx) {
-		BasePhysics* p = entry.physics;
-		if (!p) return;
-
-		// 仅当对象是动态的或首次注册时才更新网格
-		CF_ShapeWrapper ws;
-		if (entry.dirty) {
-			CF_ShapeWrapper s = p->get_shape();
-			if (p->is_world_shape_enabled()) {
-				ws = s;
-			}
-			else {
-				ws = translate_shape_world(s, p->get_position());
+// 静态层 -> 动态层（swap-remove）
+void PhysicsSystem::move_to_dynamic(size_t static_idx) noexcept
+{
+	Entry e = static_entries_[static_idx];
+	uint64_t key = make_key(e.token);
+	size_t last = static_entries_.size() - 1;
+	if (static_idx != last) {
+		static_entries_[static_idx] = static_entries_[last];
+		static_token_map_[make_key(static_entries_[static_idx].token)] = static_idx;
+	}
+	static_entries_.pop_back();
+	static_token_map_.erase(key);
+
+	e.rest_frames = 0;
+	e.auto_static = false;
+	dynamic_entries_.push_back(e);
+	dynamic_token_map_[key] = dynamic_entries_.size() - 1;
+	static_grid_dirty_ = true;
+}
+
+// 默认层矩阵：
+// - Default 与所有层碰撞
+// - Player 与 Terrain / Hazard / Trigger 碰撞
+// - Projectile 与 Terrain / Trigger 碰撞
+// - Effect 只与 Terrain 碰撞
+// - 同层之间（方块-方块、刺-刺等）以及 Terrain-Hazard 不碰撞
+void PhysicsSystem::ResetLayerMatrix() noexcept
+{
+	for (auto& row : layer_matrix_) row = 0;
+	for (uint8_t i = 0; i < static_cast<uint8_t>(CollisionLayer::Count); ++i) {
+		SetLayerCollision(CollisionLayer::Default, static_cast<CollisionLayer>(i), true);
+	}
+	SetLayerCollision(CollisionLayer::Player, CollisionLayer::Terrain, true);
+	SetLayerCollision(CollisionLayer::Player, CollisionLayer::Hazard, true);
+	SetLayerCollision(CollisionLayer::Player, CollisionLayer::Trigger, true);
+	SetLayerCollision(CollisionLayer::Projectile, CollisionLayer::Terrain, true);
+	SetLayerCollision(CollisionLayer::Projectile, CollisionLayer::Trigger, true);
+	SetLayerCollision(CollisionLayer::Effect, CollisionLayer::Terrain, true);
+}
+
+void PhysicsSystem::SetLayerCollision(CollisionLayer a, CollisionLayer b, bool enable) noexcept
+{
+	const uint8_t ia = static_cast<uint8_t>(a);
+	const uint8_t ib = static_cast<uint8_t>(b);
+	if (enable) {
+		layer_matrix_[ia] |= collision_layer_bit(b);
+		layer_matrix_[ib] |= collision_layer_bit(a);
+	}
+	else {
+		layer_matrix_[ia] &= ~collision_layer_bit(b);
+		layer_matrix_[ib] &= ~collision_layer_bit(a);
+	}
+}
+
+bool PhysicsSystem::layers_allow(const BasePhysics* a, const BasePhysics* b) const noexcept
+{
+	const CollisionLayer la = a->get_collision_layer();
+	const CollisionLayer lb = b->get_collision_layer();
+	return ShouldLayersCollide(la, lb)
+		&& (a->get_collision_mask() & collision_layer_bit(lb)) != 0
+		&& (b->get_collision_mask() & collision_layer_bit(la)) != 0;
+}
+
+void PhysicsSystem::SetWorldBounds(const CF_Aabb& bounds) noexcept
+{
+	world_bounds_ = bounds;
+	if (grid_.cell_size > 0.0f) {
+		grid_.configure(world_bounds_, grid_.cell_size);
+		static_grid_.configure(world_bounds_, grid_.cell_size);
+	}
+	static_grid_dirty_ = true;
+}
+
+void PhysicsSystem::SetBroadphase(BroadphaseType type) noexcept
+{
+	if (broadphase_ == type) return;
+	broadphase_ = type;
+	// 网格只在 Grid 模式下构建、代理列表与树只在各自的模式下维护，切换时全部从头开始
+	static_grid_dirty_ = true;
+	sap_proxies_.clear();
+	tree_.Clear();
+}
+
+void PhysicsSystem::update_sap() noexcept
+{
+	// 1) 全部代理先标记为无人认领
+	for (SapProxy& p : sap_proxies_) p.ref = kSapStale;
+
+	// 2) 每个条目认领上一帧的代理（Entry::sap_proxy 随条目在层间迁移，用 key 校验），新条目追加到末尾
+	auto claim = [&](std::vector<Entry>& entries, const std::vector<CF_Aabb>& aabbs, uint32_t tier_bit) {
+		for (size_t i = 0; i < entries.size(); ++i) {
+			Entry& e = entries[i];
+			const uint64_t key = make_key(e.token);
+			uint32_t pos = e.sap_proxy;
+			if (pos >= sap_proxies_.size() || sap_proxies_[pos].key != key || sap_proxies_[pos].ref != kSapStale) {
+				pos = static_cast<uint32_t>(sap_proxies_.size());
+				sap_proxies_.emplace_back();
+				sap_proxies_[pos].key = key;
 			}
-			world_shapes_[world_shape_idx] = ws;
+			SapProxy& p = sap_proxies_[pos];
+			p.ref = tier_bit | static_cast<uint32_t>(i);
+			p.min_x = aabbs[i].min.x;
+			p.max_x = aabbs[i].max.x;
+			p.min_y = aabbs[i].min.y;
+			p.max_y = aabbs[i].max.y;
 		}
-		else {
-			ws = world_shapes_[world_shape_idx];
+	};
+	claim(dynamic_entries_, world_aabbs_, 0u);
+	claim(static_entries_, static_world_aabbs_, kStaticRefBit);
+
+	// 3) 移除无人认领的代理（已注销的条目），保持其余代理的相对顺序
+	sap_proxies_.erase(std::remove_if(sap_proxies_.begin(), sap_proxies_.end(),
+		[](const SapProxy& p) { return p.ref == kSapStale; }), sap_proxies_.end());
+
+	// 4) 插入排序：物体帧间移动很小，数组几乎有序，代价接近线性
+	for (size_t k = 1; k < sap_proxies_.size(); ++k) {
+		if (!(sap_proxies_[k].min_x < sap_proxies_[k - 1].min_x)) continue;
+		SapProxy moving = sap_proxies_[k];
+		size_t m = k;
+		while (m > 0 && moving.min_x < sap_proxies_[m - 1].min_x) {
+			sap_proxies_[m] = sap_proxies_[m - 1];
+			--m;
 		}
+		sap_proxies_[m] = moving;
+	}
+
+	// 5) 回写每个条目在数组中的新位置
+	for (uint32_t k = 0; k < sap_proxies_.size(); ++k) {
+		const uint32_t ref = sap_proxies_[k].ref;
+		Entry& e = (ref & kStaticRefBit) ? static_entries_[ref & ~kStaticRefBit] : dynamic_entries_[ref];
+		e.sap_proxy = k;
+	}
+}
+
+void PhysicsSystem::update_tree() noexcept
+{
+	// 已注销条目的代理在 Unregister 中销毁；这里只处理新条目与离开胖包围盒的条目，
+	// 并回写条目的当前位置（条目可能因 swap-remove 或层间迁移而换了下标）
+	auto sync = [&](std::vector<Entry>& entries, const std::vector<CF_Aabb>& aabbs, uint32_t tier_bit, float margin) {
+		for (size_t i = 0; i < entries.size(); ++i) {
+			Entry& e = entries[i];
+			if (owns_tree_proxy(e)) tree_.MoveProxy(e.tree_proxy, aabbs[i], margin);
+			else e.tree_proxy = tree_.CreateProxy(aabbs[i], make_key(e.token), margin);
+			if (tree_refs_.size() < tree_.NodeCapacity()) tree_refs_.resize(tree_.NodeCapacity());
+			tree_refs_[e.tree_proxy] = tier_bit | static_cast<uint32_t>(i);
+		}
+	};
+	sync(dynamic_entries_, world_aabbs_, 0u, kTreeFatMargin);
+	sync(static_entries_, static_world_aabbs_, kStaticRefBit, 0.0f);
+}
+
+void PhysicsSystem::release_tree_proxy(Entry& e) noexcept
+{
+	if (owns_tree_proxy(e)) tree_.DestroyProxy(e.tree_proxy);
+	e.tree_proxy = DynamicAabbTree::kNull;
+}
 
-		CF_Aabb waabb = shape_wrapper_to_aabb(ws);
+const PhysicsSystem::Entry* PhysicsSystem::find_entry(uint64_t key) const noexcept
+{
+	auto it = dynamic_token_map_.find(key);
+	if (it != dynamic_token_map_.end()) return &dynamic_entries_[it->second];
+	auto sit = static_token_map_.find(key);
+	if (sit != static_token_map_.end()) return &static_entries_[sit->second];
+	return nullptr;
+}
+
+void PhysicsSystem::QueryBox(const CF_Aabb& box, std::vector<ObjManager::ObjToken>& out) const
+{
+	auto test = [&](const Entry& e) {
+		if (!e.physics) return;
+		if (DynamicAabbTree::Overlaps(shape_wrapper_to_aabb(entry_world_shape(e.physics)), box)) out.push_back(e.token);
+	};
+	// TileLayer 不进入 broadphase：直接按格子坐标取出 box 覆盖的实体格子，有任意一格即命中
+	for (const Entry& t : tile_layers_) {
+		const TileLayer* tiles = t.physics ? t.physics->as_tile_layer() : nullptr;
+		if (!tiles) continue;
+		bool any = false;
+		tiles->ForEachSolidCell(box, [&](int, int, const CF_Aabb&) { any = true; });
+		if (any) out.push_back(t.token);
+	}
+	if (broadphase_ == BroadphaseType::DynamicTree) {
+		tree_.Query(box, [&](int32_t id) {
+			if (const Entry* e = find_entry(tree_.GetUserData(id))) test(*e);
+		});
+		return;
+	}
+	for (const Entry& e : dynamic_entries_) test(e);
+	for (const Entry& e : static_entries_) test(e);
+}
+
+bool PhysicsSystem::RayCast(const CF_V2& from, const CF_V2& to, ObjManager::ObjToken* hit, float* fraction) const
+{
+	const CF_V2 delta = to - from;
+	const float length = v2math::length(delta);
+	if (length <= 1e-6f) return false;
+
+	// cf_cast_ray 要求方向为单位向量，射线长度为 t；命中距离换算为线段比例
+	CF_Ray ray{};
+	ray.p = from;
+	ray.d = delta * (1.0f / length);
+	bool found = false;
+	float best = 1.0f;
+	auto cast = [&](const Entry& e) {
+		if (!e.physics) return;
+		const CF_ShapeWrapper s = entry_world_shape(e.physics);
+		ray.t = length * best;
+		CF_Raycast rc{};
+		if (!cf_cast_ray(ray, &s.u, nullptr, s.type, &rc)) return;
+		const float f = rc.t / length;
+		if (found && f >= best) return;
+		found = true;
+		best = f;
+		if (hit) *hit = e.token;
+	};
+	// 先测 TileLayer（逐格步进），得到的最近命中会裁短之后对条目的射线
+	for (const Entry& t : tile_layers_) {
+		const TileLayer* tiles = t.physics ? t.physics->as_tile_layer() : nullptr;
+		float f = 1.0f;
+		if (!tiles || !tiles->RayCast(from, to, &f)) continue;
+		if (found && f >= best) continue;
+		found = true;
+		best = f;
+		if (hit) *hit = t.token;
+	}
+	if (broadphase_ == BroadphaseType::DynamicTree) {
+		// 回调返回当前最近命中的比例，树会裁掉更远的子树
+		tree_.RayCast(from, to, [&](int32_t id, float) {
+			if (const Entry* e = find_entry(tree_.GetUserData(id))) cast(*e);
+			return best;
+		});
+	}
+	else {
+		for (const Entry& e : dynamic_entries_) cast(e);
+		for (const Entry& e : static_entries_) cast(e);
+	}
+	if (found && fraction) *fraction = best;
+	return found;
+}
+
+void PhysicsSystem::CellGrid::configure(const CF_Aabb& bounds, float cell) noexcept
+{
+	cell_size = cell;
+	origin_x = cell_coord(bounds.min.x);
+	origin_y = cell_coord(bounds.min.y);
+	cols = std::max(0, cell_coord(bounds.max.x) - origin_x + 1);
+	rows = std::max(0, cell_coord(bounds.max.y) - origin_y + 1);
+	cell_start.assign(static_cast<size_t>(cols) * static_cast<size_t>(rows) + 1, 0);
+	cursor.resize(static_cast<size_t>(cols) * static_cast<size_t>(rows));
+	cell_items.clear();
+}
+
+void PhysicsSystem::CellGrid::build(const std::vector<CF_Aabb>& aabbs) noexcept
+{
+	const size_t cell_count = static_cast<size_t>(cols) * static_cast<size_t>(rows);
+	std::fill(cell_start.begin(), cell_start.end(), 0u);
 
-		int32_t gx0 = static_cast<int32_t>(std::floor(waabb.min.x / cell_size));
-		int32_t gy0 = static_cast<int32_t>(std::floor(waabb.min.y / cell_size));
-		int32_t gx1 = static_cast<int32_t>(std::floor(waabb.max.x / cell_size));
-		int32_t gy1 = static_cast<int32_t>(std::floor(waabb.max.y / cell_size));
+	// 清空上次使用过的越界 bucket（保留容量以便复用）
+	for (uint64_t k : overflow_keys_used) {
+		auto it = overflow.find(k);
+		if (it != overflow.end()) it->second.clear();
+	}
+	overflow_keys_used.clear();
 
-		for (int32_t gx = gx0; gx <= gx1; ++gx) {
-			for (int32_t gy = gy0; gy <= gy1; ++gy) {
-				uint64_t gkey = grid_key(gx, gy);
-				grid_[gkey].push_back(world_shape_idx);
-				grid_keys_used_.emplace_back(gkey);
+	// 第一趟：计算每个条目覆盖的格子范围并计数，越界格子直接放入 overflow
+	ranges.resize(aabbs.size());
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		CellRange& r = ranges[i];
+		r.x0 = cell_coord(aabbs[i].min.x);
+		r.y0 = cell_coord(aabbs[i].min.y);
+		r.x1 = cell_coord(aabbs[i].max.x);
+		r.y1 = cell_coord(aabbs[i].max.y);
+		for (int32_t gy = r.y0; gy <= r.y1; ++gy) {
+			const int32_t ly = gy - origin_y;
+			for (int32_t gx = r.x0; gx <= r.x1; ++gx) {
+				const int32_t lx = gx - origin_x;
+				if (lx >= 0 && ly >= 0 && lx < cols && ly < rows) {
+					++cell_start[static_cast<size_t>(ly) * cols + lx + 1];
+				}
+				else {
+					uint64_t key = grid_key(gx, gy);
+					auto& bucket = overflow[key];
+					if (bucket.empty()) overflow_keys_used.push_back(key);
+					bucket.push_back(static_cast<uint32_t>(i));
+				}
 			}
 		}
+	}
 
-		CF_V2 center = (waabb.min + waabb.max) * 0.5f;
-		entry.grid_x = static_cast<int32_t>(std::floor(center.x / cell_size));
-		entry.grid_y = static_cast<int32_t>(std::floor(center.y / cell_size));
+	// 前缀和：cell_start[c] 成为第 c 格在 cell_items 中的起始位置
+	for (size_t c = 0; c < cell_count; ++c) cell_start[c + 1] += cell_start[c];
+	cell_items.resize(cell_start[cell_count]);
+	item_min_x.resize(cell_items.size());
+	item_min_y.resize(cell_items.size());
+	item_max_x.resize(cell_items.size());
+	item_max_y.resize(cell_items.size());
+	source = &aabbs;
+	std::copy(cell_start.begin(), cell_start.begin() + cell_count, cursor.begin());
+
+	// 第二趟：按格子写入连续索引数组
+	for (size_t i = 0; i < aabbs.size(); ++i) {
+		const CellRange& r = ranges[i];
+		const int32_t y0 = std::max(r.y0, origin_y), y1 = std::min(r.y1, origin_y + rows - 1);
+		const int32_t x0 = std::max(r.x0, origin_x), x1 = std::min(r.x1, origin_x + cols - 1);
+		for (int32_t gy = y0; gy <= y1; ++gy) {
+			const size_t row = static_cast<size_t>(gy - origin_y) * cols;
+			for (int32_t gx = x0; gx <= x1; ++gx) {
+				const uint32_t k = cursor[row + (gx - origin_x)]++;
+				cell_items[k] = static_cast<uint32_t>(i);
+				item_min_x[k] = aabbs[i].min.x;
+				item_min_y[k] = aabbs[i].min.y;
+				item_max_x[k] = aabbs[i].max.x;
+				item_max_y[k] = aabbs[i].max.y;
+			}
+		}
+	}
+}
+
+void PhysicsSystem::Step(float cell_size) noexcept
+{
+	events_.clear();
+	if (dynamic_entries_.empty() && static_entries_.empty()) return;
 
+	// 1) 检查静态层：被取消静态标记、或自动升级后又移动的条目降回动态层；
+	//    显式静态条目若被移动则仅标记静态网格重建
+	for (size_t i = 0; i < static_entries_.size(); ) {
+		Entry& e = static_entries_[i];
+		BasePhysics* p = e.physics;
+		if (!p) { ++i; continue; }
+		p->get_shape(); // 触发惰性 world shape 更新以刷新版本号
+		const bool moved = p->world_shape_version() != e.shape_version;
+		if (!p->is_static() && (!e.auto_static || moved)) {
+			move_to_dynamic(i);
+			continue; // swap-remove 后当前位置是新条目
+		}
+		if (moved) {
+			e.shape_version = p->world_shape_version();
+			static_grid_dirty_ = true;
+		}
 		p->clear_position_dirty();
-	};
+		++i;
+	}
 
-	// 更新动态对象
-	for (size_t i = 0; i < dynamic_entries_.size(); ++i) {
-		update_entry_in_grid(dynamic_entries_[i], i);
+	// 2) 检查动态层：显式静态的条目立即迁入静态层；
+	//    速度/外力为零且形状未变化的 SOLID/VOID 条目静止足够久后自动迁入
+	for (size_t i = 0; i < dynamic_entries_.size(); ) {
+		Entry& e = dynamic_entries_[i];
+		BasePhysics* p = e.physics;
+		if (!p) { ++i; continue; }
+		p->get_shape();
+		const uint64_t ver = p->world_shape_version();
+		if (p->is_static()) {
+			e.shape_version = ver;
+			e.auto_static = false;
+			move_to_static(i);
+			continue;
+		}
+		const ColliderType ct = p->get_collider_type();
+		const CF_V2& v = p->get_velocity();
+		const CF_V2& f = p->get_force();
+		const bool at_rest = ver == e.shape_version && v.x == 0.0f && v.y == 0.0f && f.x == 0.0f && f.y == 0.0f;
+		e.shape_version = ver;
+		if (at_rest && ct != ColliderType::LIQUID) {
+			if (++e.rest_frames >= kAutoStaticRestFrames) {
+				e.auto_static = true;
+				move_to_static(i);
+				continue;
+			}
+		}
+		else {
+			e.rest_frames = 0;
+		}
+		++i;
 	}
 
-	// 更新静态对象（仅在首次或需要时）
-	size_t static_offset = dynamic_entries_.size();
-	for (size_t i = 0; i < static_entries_.size(); ++i) {
-		update_entry_in_grid(static_entries_[i], static_offset + i);
+	// 3) 网格尺寸变化时重新配置稠密区域；静态网格仅在静态集合变化时重建
+	if (grid_.cell_size != cell_size) {
+		grid_.configure(world_bounds_, cell_size);
+		static_grid_.configure(world_bounds_, cell_size);
+		static_grid_dirty_ = true;
 	}
+	if (static_grid_dirty_) {
+		static_world_shapes_.resize(static_entries_.size());
+		static_world_aabbs_.resize(static_entries_.size());
+		for (size_t i = 0; i < static_entries_.size(); ++i) {
+			BasePhysics* p = static_entries_[i].physics;
+			static_world_shapes_[i] = p ? entry_world_shape(p) : CF_ShapeWrapper{};
+			static_world_aabbs_[i] = shape_wrapper_to_aabb(static_world_shapes_[i]);
+		}
+		if (broadphase_ == BroadphaseType::Grid) static_grid_.build(static_world_aabbs_);
+		static_grid_dirty_ = false;
+	}
+
+	// 4) 重建动态网格：只为动态条目计算 world shape 与 AABB
+	world_shapes_.resize(dynamic_entries_.size());
+	world_aabbs_.resize(dynamic_entries_.size());
 
+	for (size_t i = 0; i < dynamic_entries_.size(); ++i) {
+		Entry& entry = dynamic_entries_[i];
+		BasePhysics* p = entry.physics;
+		world_shapes_[i] = p ? entry_world_shape(p) : CF_ShapeWrapper{};
+		const CF_Aabb& waabb = world_aabbs_[i] = shape_wrapper_to_aabb(world_shapes_[i]);
 
-	// 进行 narrowphase
+		CF_V2 center = (waabb.min + waabb.max) * 0.5f;
+		entry.grid_x = grid_.cell_coord(center.x);
+		entry.grid_y = grid_.cell_coord(center.y);
+
+		if (p) p->clear_position_dirty();
+	}
+	if (broadphase_ == BroadphaseType::Grid) grid_.build(world_aabbs_);
+	else if (broadphase_ == BroadphaseType::SweepAndPrune) update_sap();
+	else update_tree();
+
+	// 5) 进行 narrowphase：只有动态条目作为 a，b 可以是动态（j > i）或静态
 	events_.reserve(dynamic_entries_.size() * 2); // 预估容量
 
-	// 辅助函数：执行碰撞检测
-	auto check_collisions_for_bucket = [&](size_t i, const std::vector<size_t>& bucket) {
-		Entry& a_entry = (i < static_offset) ? dynamic_entries_[i] : static_entries_[i - static_offset];
+	// 辅助函数：记录一次碰撞事件（distance 用于回调排序）
+	auto push_event = [&](const Entry& a_entry, const Entry& b_entry, const CF_Manifold& m, bool oriented) {
+		CollisionEvent ev;
+		ev.a = a_entry.token;
+		ev.b = b_entry.token;
+		ev.manifold = m;
+		ev.oriented = oriented;
+
+		CF_V2 aver = cf_v2(0.0f, 0.0f);
+		for (int p = 0; p < m.count; p++) aver += m.contact_points[p];
+		aver = aver * (1.0f / static_cast<float>(m.count));
+		ev.distance_a = v2math::length(aver - a_entry.physics->get_position());
+		ev.distance_b = v2math::length(aver - b_entry.physics->get_position());
+
+		events_.push_back(ev);
+	};
+
+	// 辅助函数：对单个候选对执行碰撞检测
+	auto check_pair = [&](size_t i, const Entry& b_entry, const CF_ShapeWrapper& bw) {
+		const Entry& a_entry = dynamic_entries_[i];
 		BasePhysics* pa = a_entry.physics;
-		if (!pa || pa->get_collider_type() == ColliderType::VOID) return;
-
-		for (size_t j_idx : bucket) {
-			if (j_idx <= i) continue;
-
-			Entry& b_entry = (j_idx < static_offset) ? dynamic_entries_[j_idx] : static_entries_[j_idx - static_offset];
-			BasePhysics* pb = b_entry.physics;
-			if (!pb || pb->get_collider_type() == ColliderType::VOID) continue;
-
-			CF_Manifold m{};
-			const CF_ShapeWrapper& aw = world_shapes_[i];
-			const CF_ShapeWrapper& bw = world_shapes_[j_idx];
-			if (shapes_collide_world(aw, bw, &m)) {
-				CollisionEvent ev;
-				ev.a = a_entry.token;
-				ev.b = b_entry.token;
-				ev.manifold = m;
-
-				CF_V2 aver = cf_v2(0.0f, 0.0f);
-				for (int p = 0; p < m.count; p++) aver += m.contact_points[p];
-				aver = aver * (1.0f / static_cast<float>(m.count));
-				ev.distance_a = v2math::length(aver - pa->get_position());
-				ev.distance_b = v2math::length(aver - pb->get_position());
-
-				events_.push_back(ev);
-			}
-		}
+		BasePhysics* pb = b_entry.physics;
+		if (!pb || pb->get_collider_type() == ColliderType::VOID) return;
+		if (!layers_allow(pa, pb)) return; // 层矩阵过滤：不需要的对不进入 narrowphase
+
+		CF_Manifold m{};
+		const CF_ShapeWrapper& aw = world_shapes_[i];
+		if (collide_world_dispatch(aw, bw, &m)) push_event(a_entry, b_entry, m, false);
+	};
+
+	// 辅助函数：动态条目与 TileLayer 的检测（只测试与其 AABB 重叠的实体格子）
+	auto check_tiles = [&](size_t i, const Entry& t_entry) {
+		const Entry& a_entry = dynamic_entries_[i];
+		BasePhysics* pt = t_entry.physics;
+		if (!pt || pt->get_collider_type() == ColliderType::VOID) return;
+		if (!layers_allow(a_entry.physics, pt)) return;
+
+		CF_Manifold m{};
+		if (!pt->as_tile_layer()->CollideShape(world_shapes_[i], &m)) return;
+		normalize_and_clamp_manifold(m);
+		push_event(a_entry, t_entry, m, true);
+	};
+
+	// 动态条目能否作为 a 参与检测：VOID 或该层与任何层都不碰撞时直接跳过
+	auto dynamic_active = [&](size_t i) {
+		const BasePhysics* p = dynamic_entries_[i].physics;
+		if (!p || p->get_collider_type() == ColliderType::VOID) return false;
+		return (layer_matrix_[static_cast<uint8_t>(p->get_collision_layer())] & p->get_collision_mask()) != 0;
 	};
 
 	for (size_t i = 0; i < dynamic_entries_.size(); ++i) {
-		Entry& a = dynamic_entries_[i];
+		if (!dynamic_active(i)) continue;
+		for (const Entry& t : tile_layers_) check_tiles(i, t);
+		const CF_Aabb& a_aabb = world_aabbs_[i];
+
+		// DynamicTree：以紧包围盒查询树（命中的是胖包围盒），候选再以紧包围盒筛一次；动态-动态对只在 j > i 时测试
+		if (broadphase_ == BroadphaseType::DynamicTree) {
+			tree_.Query(a_aabb, [&](int32_t id) {
+				const uint32_t ref = tree_refs_[id];
+				const uint32_t j = ref & ~kStaticRefBit;
+				if (ref & kStaticRefBit) {
+					if (DynamicAabbTree::Overlaps(a_aabb, static_world_aabbs_[j])) check_pair(i, static_entries_[j], static_world_shapes_[j]);
+				}
+				else if (j > i && DynamicAabbTree::Overlaps(a_aabb, world_aabbs_[j])) {
+					check_pair(i, dynamic_entries_[j], world_shapes_[j]);
+				}
+			});
+			continue;
+		}
+		if (broadphase_ != BroadphaseType::Grid) continue;
+
+		const Entry& a = dynamic_entries_[i];
 		for (int dx = -1; dx <= 1; ++dx) {
 			for (int dy = -1; dy <= 1; ++dy) {
-				uint64_t nkey = grid_key(a.grid_x + dx, a.grid_y + dy);
-				auto nit = grid_.find(nkey);
-				if (nit != grid_.end()) {
-					check_collisions_for_bucket(i, nit->second);
-				}
+				const int32_t gx = a.grid_x + dx;
+				const int32_t gy = a.grid_y + dy;
+				// 先以 SoA 包围盒批量筛掉不重叠的候选，再进入 narrowphase
+				grid_.for_each_overlap_in_cell(gx, gy, a_aabb, [&](uint32_t j) {
+					if (j <= i) return;
+					check_pair(i, dynamic_entries_[j], world_shapes_[j]);
+				});
+				static_grid_.for_each_overlap_in_cell(gx, gy, a_aabb, [&](uint32_t j) {
+					check_pair(i, static_entries_[j], static_world_shapes_[j]);
+				});
 			}
 		}
 	}
 
-	// 进行 narrowphase后排序和去重
-	auto make_pair_key_and_ordered_tokens = [this](const ObjManager::ObjToken& t1, const ObjManager::ObjToken& t2,
-		uint64_t& out_key, ObjManager::ObjToken& out_first, ObjManager::ObjToken& out_second) noexcept
-		{
-			uint64_t k1 = make_key(t1);
-			uint64_t k2 = make_key(t2);
-			if (k1 <= k2) {
-				out_first = t1;
-				out_second = t2;
-				out_key = k1 ^ (k2 + 0x9e3779b97f4a7c15ULL + (k1 << 6) + (k1 >> 2));
+	// SweepAndPrune：按 min_x 顺序扫描，活跃列表中 max_x 已落后的代理被移除；
+	// 动态代理与活跃的动态、静态代理比较，静态代理只与活跃的动态代理比较（静态-静态对不测试）
+	if (broadphase_ == BroadphaseType::SweepAndPrune) {
+		auto sap_pair = [&](const SapProxy& p, const SapProxy& q) {
+			if (q.min_y > p.max_y || q.max_y < p.min_y) return;
+			const bool p_static = (p.ref & kStaticRefBit) != 0;
+			const bool q_static = (q.ref & kStaticRefBit) != 0;
+			const uint32_t pi = p.ref & ~kStaticRefBit;
+			const uint32_t qi = q.ref & ~kStaticRefBit;
+			if (p_static || q_static) {
+				const uint32_t di = p_static ? qi : pi;
+				const uint32_t si = p_static ? pi : qi;
+				if (dynamic_active(di)) check_pair(di, static_entries_[si], static_world_shapes_[si]);
+				return;
 			}
-			else {
-				out_first = t2;
-				out_second = t1;
-				out_key = k2 ^ (k1 + 0x9e3779b97f4a7c15ULL + (k2 << 6) + (k2 >> 2));
+			// 两个动态条目：与网格路径一致，以较小的下标作为 a
+			const uint32_t i = std::min(pi, qi);
+			const uint32_t j = std::max(pi, qi);
+			if (dynamic_active(i)) check_pair(i, dynamic_entries_[j], world_shapes_[j]);
+		};
+		auto sweep_active = [&](std::vector<uint32_t>& active, const SapProxy& p) {
+			for (size_t k = 0; k < active.size(); ) {
+				const SapProxy& q = sap_proxies_[active[k]];
+				if (q.max_x < p.min_x) {
+					active[k] = active.back();
+					active.pop_back();
+					continue;
+				}
+				sap_pair(p, q);
+				++k;
 			}
 		};
-	
-	if (!events_.empty()) {
-		std::unordered_map<uint64_t, CollisionEvent> unique_events;
-		unique_events.reserve(events_.size());
-		for (const auto& ev : events_) {
-			uint64_t pair_key;
-			ObjManager::ObjToken first_tok;
-			ObjManager::ObjToken second_tok;
-			make_pair_key_and_ordered_tokens(ev.a, ev.b, pair_key, first_tok, second_tok);
-			auto emplaced = unique_events.emplace(pair_key, ev);
-			if (!emplaced.second) {
-				merge_manifold_contact_points(emplaced.first->second.manifold, ev.manifold);
+		sap_active_dynamic_.clear();
+		sap_active_static_.clear();
+		for (uint32_t k = 0; k < sap_proxies_.size(); ++k) {
+			const SapProxy& p = sap_proxies_[k];
+			const bool p_static = (p.ref & kStaticRefBit) != 0;
+			sweep_active(sap_active_dynamic_, p);
+			if (!p_static) sweep_active(sap_active_static_, p);
+			(p_static ? sap_active_static_ : sap_active_dynamic_).push_back(k);
+		}
+	}
+
+	// 6) 去重：以 pair key 排序后合并相邻的重复事件（同一对最多保留两个不同 contact）
+	for (CollisionEvent& ev : events_) ev.pair_key = make_pair_key(ev.a, ev.b);
+	if (events_.size() > 1) {
+		// stable：同一对的多个事件保持 narrowphase 的产生顺序，合并结果与运行无关
+		std::stable_sort(events_.begin(), events_.end(), [](const CollisionEvent& lhs, const CollisionEvent& rhs) {
+			return lhs.pair_key < rhs.pair_key;
+		});
+		size_t out = 0;
+		for (size_t k = 1; k < events_.size(); ++k) {
+			if (events_[k].pair_key == events_[out].pair_key) {
+				merge_manifold_contact_points(events_[out].manifold, events_[k].manifold);
+			}
+			else if (++out != k) {
+				events_[out] = events_[k];
 			}
 		}
-		events_.clear();
-		events_.reserve(unique_events.size());
-		for (auto& kv : unique_events) {
-			events_.push_back(kv.second);
+		events_.resize(out + 1);
+	}
+
+	// 7) 本帧接触对（按 key 有序）与上一帧做一次线性归并：两边都有为 Stay，只在本帧为 Enter，只在上一帧为 Exit
+	ObjManager& objs = ObjManager::Instance();
+	current_pairs_.clear();
+	exit_pairs_.clear();
+	size_t pi = 0;
+	for (CollisionEvent& ev : events_) {
+		ev.stay = false;
+		if (!objs.IsValid(ev.a) || !objs.IsValid(ev.b)) {
+			ev.pair_key = kNoPairKey; // 分发阶段跳过
+			continue;
+		}
+		while (pi < prev_pairs_.size() && prev_pairs_[pi].key < ev.pair_key) {
+			if (prev_pairs_[pi].alive) exit_pairs_.push_back(prev_pairs_[pi]);
+			++pi;
 		}
+		if (pi < prev_pairs_.size() && prev_pairs_[pi].key == ev.pair_key) {
+			ev.stay = prev_pairs_[pi].alive;
+			++pi;
+		}
+		const ContactPair cp = make_contact_pair(ev.pair_key, ev.a, ev.b);
+		if (!ev.stay) link_pair(cp);
+		current_pairs_.push_back(cp);
+	}
+	for (; pi < prev_pairs_.size(); ++pi) {
+		if (prev_pairs_[pi].alive) exit_pairs_.push_back(prev_pairs_[pi]);
 	}
+	for (const ContactPair& cp : exit_pairs_) unlink_pair(cp);
+	prev_pairs_.swap(current_pairs_);
 
+	// 8) 按距离排序后分发 Enter/Stay（距离相同时保持 pair key 顺序）
 	if (events_.size() > 1) {
-		std::sort(events_.begin(), events_.end(), [](const CollisionEvent& lhs, const CollisionEvent& rhs) {
+		std::stable_sort(events_.begin(), events_.end(), [](const CollisionEvent& lhs, const CollisionEvent& rhs) {
 			return lhs.distance_a != rhs.distance_a? lhs.distance_a < rhs.distance_a : lhs.distance_b < rhs.distance_b;
 		});
 	}
 
-	// 使用事件产生 Enter/Stay/Exit 回调序列
-	current_pairs_.clear();
-	current_pairs_.reserve(events_.size() * 2);
-
 	for (const auto& ev : events_) {
-		if (!ObjManager::Instance().IsValid(ev.a) || !ObjManager::Instance().IsValid(ev.b)) continue;
-
-		uint64_t pair_key;
-		ObjManager::ObjToken first_tok;
-		ObjManager::ObjToken second_tok;
-		make_pair_key_and_ordered_tokens(ev.a, ev.b, pair_key, first_tok, second_tok);
-
-		current_pairs_.emplace(pair_key, std::make_pair(first_tok, second_tok));
-
-		auto prev_it = prev_collision_pairs_.find(pair_key);
-		const bool was_colliding = (prev_it != prev_collision_pairs_.end());
+		if (ev.pair_key == kNoPairKey) continue;
 
 		// 使用 token-based 的 operator[] 获取对象引用（在前面已通过 IsValid 校验，operator[] 不应抛出）
-		BaseObject& oa = ObjManager::Instance()[ev.a];
-		BaseObject& ob = ObjManager::Instance()[ev.b];
+		BaseObject& oa = objs[ev.a];
+		BaseObject& ob = objs[ev.b];
 
 		auto orient_manifold = [](const CF_Manifold& src, const BaseObject& self, const BaseObject& other) {
 			CF_Manifold out = src;
@@ -454,44 +1074,46 @@ void PhysicsSystem::Step(float cell_size) noexcept
 			return out;
 			};
 
-		CF_Manifold manifold_for_a = orient_manifold(ev.manifold, oa, ob);
-		CF_Manifold manifold_for_b = orient_manifold(ev.manifold, ob, oa);
-			if (was_colliding) {
+		CF_Manifold manifold_for_a = ev.manifold;
+		CF_Manifold manifold_for_b = ev.manifold;
+		if (ev.oriented) {
+			manifold_for_b.n = -manifold_for_b.n;
+		}
+		else {
+			manifold_for_a = orient_manifold(ev.manifold, oa, ob);
+			manifold_for_b = orient_manifold(ev.manifold, ob, oa);
+		}
+			if (ev.stay) {
 				oa.OnCollisionState(ev.b, manifold_for_a, BaseObject::CollisionPhase::Stay);
 				ob.OnCollisionState(ev.a, manifold_for_b, BaseObject::CollisionPhase::Stay);
 			}
 			else {
 #if COLLISION_DEBUG
 				// Enter 打印简短信息
-				OUTPUT({ "Physics" }, "Collision Enter: a =", ev.a.index, "b =", ev.b.index);
+				LOG_TRACE(Physics, "Collision Enter: a =", ev.a.index, "b =", ev.b.index);
 #endif
 				oa.OnCollisionState(ev.b, manifold_for_a, BaseObject::CollisionPhase::Enter);
 				ob.OnCollisionState(ev.a, manifold_for_b, BaseObject::CollisionPhase::Enter);
 			}
 	}
 
-	// 对上帧存在但本帧消失的对触发 Exit 回调
-	for (const auto& prev_pair : prev_collision_pairs_) {
-		uint64_t key = prev_pair.first;
-		if (current_pairs_.find(key) == current_pairs_.end()) {
-			const auto& tok_pair = prev_pair.second;
-			const ObjManager::ObjToken& ta = tok_pair.first;
-			const ObjManager::ObjToken& tb = tok_pair.second;
+	// 9) 对上帧存在但本帧消失的对触发 Exit 回调（按 pair key 顺序）
+	for (const ContactPair& cp : exit_pairs_) {
+		const ObjManager::ObjToken& ta = cp.first;
+		const ObjManager::ObjToken& tb = cp.second;
 
-			if (!ObjManager::Instance().IsValid(ta) || !ObjManager::Instance().IsValid(tb)) continue;
+		if (!objs.IsValid(ta) || !objs.IsValid(tb)) continue;
 
-			// 使用 operator[] 获取引用（已校验）
-			BaseObject& oa = ObjManager::Instance()[ta];
-			BaseObject& ob = ObjManager::Instance()[tb];
+		// 使用 operator[] 获取引用（已校验）
+		BaseObject& oa = objs[ta];
+		BaseObject& ob = objs[tb];
 
 #if COLLISION_DEBUG
-			// Exit 只打印简短摘要
-			OUTPUT({"Physics"}, "Collision EXIT: a =", ta.index, "b =", tb.index);
+		// Exit 只打印简短摘要
+		LOG_TRACE(Physics, "Collision EXIT: a =", ta.index, "b =", tb.index);
 #endif
 
-			oa.OnCollisionState(tb, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
-			ob.OnCollisionState(ta, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
-		}
+		oa.OnCollisionState(tb, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
+		ob.OnCollisionState(ta, CF_Manifold{}, BaseObject::CollisionPhase::Exit);
 	}
-	prev_collision_pairs_.swap(current_pairs_);
-}
\ No newline at end of file
+}
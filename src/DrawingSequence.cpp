@@ -1,7 +1,7 @@
 #include "drawing_sequence.h"
 #include "base_object.h"
+#include "tile_layer.h"
 #include "debug_config.h"
-#include "UI_draw.h"
 #include <algorithm>
 #include <iostream>
 #include <internal/cute_draw_internal.h>
@@ -111,6 +111,27 @@ static void PushFrameSprite(const CF_Sprite* spr, int frame_index, int frame_cou
     }
 }
 
+//  TileLayer зǿոͬһ spriteÿƵɫ spriteŵӳߴ粢ԸĶλ
+static void PushTileLayer(const TileLayer& tiles)
+{
+    const std::vector<CF_Sprite>& palette = tiles.PaletteSprites();
+    const float size = tiles.TileSize();
+    for (int cy = 0; cy < tiles.Rows(); ++cy) {
+        for (int cx = 0; cx < tiles.Cols(); ++cx) {
+            const int idx = tiles.GetTile(cx, cy);
+            if (idx < 0 || idx >= static_cast<int>(palette.size())) continue;
+            CF_Sprite spr = palette[idx];
+            if (!spr.easy_sprite_id || spr.w <= 0 || spr.h <= 0) continue;
+            const CF_Aabb cell = tiles.CellAabb(cx, cy);
+            spr.scale = cf_v2(size / spr.w, size / spr.h);
+            spr.offset = cf_v2(0.0f, 0.0f);
+            spr.transform = cf_make_transform();
+            spr.transform.p = (cell.min + cell.max) * 0.5f;
+            PushFrameSprite(&spr, 0, 1);
+        }
+    }
+}
+
 DrawingSequence& DrawingSequence::Instance() noexcept
 {
     static DrawingSequence instance;
@@ -121,104 +142,246 @@ void DrawingSequence::Register(BaseObject* obj) noexcept
 {
     if (!obj) return;
     std::lock_guard<std::mutex> lock(m_mutex);
-    for (size_t i = 0; i < m_entries.size(); ++i) {
-        if (m_entries[i]->owner == obj) {
-            OUTPUT(Header{ "DrawingSequence" },
-                "Register skipped (already registered)", "obj=", obj,
-                "table_index=", i, "reg_index=", m_entries[i]->reg_index);
-            return;
-        }
+    // ¼λظעΪ O(1)
+    if (obj->m_draw_slot != BaseObject::kNoDrawSlot) {
+        LOG_WARN(DrawingSequence,
+            "Register skipped (already registered)", "obj=", obj,
+            "slot=", obj->m_draw_slot, "reg_index=", m_slots[obj->m_draw_slot].reg_index);
+        return;
+    }
+    uint32_t slot;
+    if (!m_free_slots.empty()) {
+        slot = m_free_slots.back();
+        m_free_slots.pop_back();
     }
-    auto new_entry = std::make_unique<Entry>();
-    new_entry->owner = obj;
-    new_entry->reg_index = m_next_reg_index++;
-    size_t table_index = m_entries.size();
-    m_entries.push_back(std::move(new_entry));
-    OUTPUT(Header{ "DrawingSequence" },
+    else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+    Entry& entry = m_slots[slot];
+    entry.owner = obj;
+    entry.reg_index = m_next_reg_index++;
+    entry.depth = obj->GetDepth();
+    obj->m_draw_slot = slot;
+    ++m_live_count;
+    BucketInsert(slot);
+    LOG_TRACE(DrawingSequence,
         "Registered obj=", obj,
-        "table_index=", table_index,
-        "reg_index=", m_entries.back()->reg_index);
+        "slot=", slot,
+        "reg_index=", entry.reg_index);
+}
+
+void DrawingSequence::Reserve(size_t additional)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    // вλȸãֻΪݣʱٷ
+    if (additional <= m_free_slots.size()) return;
+    const size_t need = m_slots.size() + (additional - m_free_slots.size());
+    if (need > m_slots.capacity()) m_slots.reserve(std::max(need, m_slots.capacity() * 2));
 }
 
 void DrawingSequence::Unregister(BaseObject* obj) noexcept
 {
     if (!obj) return;
     std::lock_guard<std::mutex> lock(m_mutex);
-    auto it = std::find_if(m_entries.begin(), m_entries.end(),
-        [obj](const std::unique_ptr<Entry>& entry) {
-            return entry->owner == obj;
-        });
-    if (it == m_entries.end()) {
-        OUTPUT(Header{ "DrawingSequence" },
-            "Unregister failed (not found)", "obj=", obj);
+    const uint32_t slot = obj->m_draw_slot;
+    // δעᣨѱ UnregisterAll Ķֱӷ
+    if (slot == BaseObject::kNoDrawSlot) return;
+    if (slot >= m_slots.size() || m_slots[slot].owner != obj) {
+        LOG_WARN(DrawingSequence,
+            "Unregister failed (stale slot)", "obj=", obj, "slot=", slot);
+        obj->m_draw_slot = BaseObject::kNoDrawSlot;
         return;
     }
-    size_t table_index = std::distance(m_entries.begin(), it);
-    int reg_index = (*it)->reg_index;
-    m_entries.erase(it);
-    OUTPUT(Header{ "DrawingSequence" },
+    Entry& entry = m_slots[slot];
+    const uint64_t reg_index = entry.reg_index;
+    // ֻͷŲλͰеĿ owner ΪնʧЧѹʱƳ
+    entry.owner = nullptr;
+    obj->m_draw_slot = BaseObject::kNoDrawSlot;
+    m_free_slots.push_back(slot);
+    --m_live_count;
+    ++m_stale_items;
+    if (m_stale_items > 64 && m_stale_items > m_live_count) CompactBuckets();
+    LOG_TRACE(DrawingSequence,
         "Unregistered obj=", obj,
-        "table_index=", table_index,
+        "slot=", slot,
         "reg_index=", reg_index);
 }
 
+// ȱ仯ʱµ stamp Ŀ׷ӵȵͰУͰеĿ֮ʧЧ˳ʼ
+void DrawingSequence::OnDepthChanged(BaseObject* obj) noexcept
+{
+    if (!obj) return;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const uint32_t slot = obj->m_draw_slot;
+    if (slot == BaseObject::kNoDrawSlot || slot >= m_slots.size() || m_slots[slot].owner != obj) return;
+    Entry& entry = m_slots[slot];
+    const int depth = obj->GetDepth();
+    if (entry.depth == depth) return;
+    entry.depth = depth;
+    ++m_stale_items;
+    BucketInsert(slot);
+    if (m_stale_items > 64 && m_stale_items > m_live_count) CompactBuckets();
+}
+
+void DrawingSequence::UnregisterAll() noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Entry& entry : m_slots) {
+        if (entry.owner) entry.owner->m_draw_slot = BaseObject::kNoDrawSlot;
+    }
+    LOG_INFO(DrawingSequence, "UnregisterAll: dropped", m_live_count, "entries");
+    // һͨעĶ
+    m_slots.clear();
+    m_free_slots.clear();
+    m_buckets.clear();
+    m_live_count = 0;
+    m_stale_items = 0;
+}
+
+size_t DrawingSequence::GetRegisteredCount() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_live_count;
+}
+
+// Ͱm_buckets  depth Ͱڰ reg_index 
+// עĿ reg_index ֱ׷ӵͰβıȵĿͬ׷ӣƻ˳ǸͰ
+void DrawingSequence::BucketInsert(uint32_t slot)
+{
+    Entry& entry = m_slots[slot];
+    entry.stamp = m_next_stamp++;
+    auto bit = std::lower_bound(m_buckets.begin(), m_buckets.end(), entry.depth,
+        [](const DepthBucket& b, int d) { return b.depth < d; });
+    if (bit == m_buckets.end() || bit->depth != entry.depth) {
+        DepthBucket bucket;
+        bucket.depth = entry.depth;
+        bit = m_buckets.insert(bit, std::move(bucket));
+    }
+    auto& items = bit->items;
+    if (!items.empty() && items.back().reg_index > entry.reg_index) bit->needs_sort = true;
+    items.push_back(BucketItem{ slot, entry.stamp, entry.reg_index });
+}
+
+// ȶѹƳʧЧĿ˳򣬱ҪʱȰ reg_index ָ˳
+void DrawingSequence::CompactBucket(DepthBucket& bucket)
+{
+    auto& items = bucket.items;
+    if (bucket.needs_sort) {
+        std::stable_sort(items.begin(), items.end(),
+            [](const BucketItem& l, const BucketItem& r) { return l.reg_index < r.reg_index; });
+        bucket.needs_sort = false;
+    }
+    items.erase(std::remove_if(items.begin(), items.end(),
+        [this](const BucketItem& item) { return !IsLive(item); }), items.end());
+}
+
+void DrawingSequence::CompactBuckets()
+{
+    for (DepthBucket& bucket : m_buckets) CompactBucket(bucket);
+    m_buckets.erase(std::remove_if(m_buckets.begin(), m_buckets.end(),
+        [](const DepthBucket& b) { return b.items.empty(); }), m_buckets.end());
+    m_stale_items = 0;
+}
+
+// Ըǲ㣺ֵʽ¼״ײΣûκÿ֡ѷ
+// SHAPE_DEBUG / COLLISION_DEBUG رʱ¼ڱڱƳ
+void DrawingSequence::RecordDebugOverlay(const BaseObject* obj)
+{
+#if SHAPE_DEBUG
+    if (obj->GetColliderType() != ColliderType::VOID) m_debug_shapes.push_back(obj->GetShape());
+#endif
+#if COLLISION_DEBUG
+    for (const CF_Manifold& m : obj->m_collide_manifolds) m_debug_manifolds.push_back(m);
+#endif
+    (void)obj;
+}
+
+void DrawingSequence::DrawDebugOverlay()
+{
+#if SHAPE_DEBUG || COLLISION_DEBUG
+    std::lock_guard<std::mutex> lock(m_mutex);
+#if SHAPE_DEBUG
+    for (const CF_ShapeWrapper& s : m_debug_shapes) RenderShapeOutlineDebug(s);
+#endif
+#if COLLISION_DEBUG
+    for (const CF_Manifold& m : m_debug_manifolds) ManifoldDrawDebug(m);
+#endif
+#endif
+}
+
+void DrawingSequence::SetRecordOnly(bool record_only) noexcept
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_record_only = record_only;
+    LOG_INFO(DrawingSequence, "Record-only mode:", record_only);
+}
+
 void DrawingSequence::DrawAll()
 {
     std::lock_guard<std::mutex> lock(m_mutex);
-    last_image_id = CF_PREMADE_ID_RANGE_LO - 1;
-    s_pending_sprites.clear();
-    s_pending_sprites.reserve(kSpriteChunkSize);
-    // Ⱥע˳򣬱֤Ⱦȶ
-    std::sort(m_entries.begin(), m_entries.end(), [](const auto& a, const auto& b) {
-        int depth_a = a->owner->GetDepth();
-        int depth_b = b->owner->GetDepth();
-        if (depth_a != depth_b) {
-            return depth_a < depth_b;
-        }
-        return a->reg_index < b->reg_index;
-    });
-
-    for (const auto& entry : m_entries) {
-        if (entry->owner && entry->owner->IsVisible()) {
-            BaseObject* obj = entry->owner;
-            CF_Sprite& sprite = obj->GetSprite();
-
-            // ˢ¶
-            cf_sprite_update(&sprite);
-
-            // ʹöλø transform
-            CF_V2 pos = obj->GetPosition();
-            sprite.transform.p = pos;
-
-            DrawUI::on_draw_ui.add(
-                [=]() {obj->ShapeDraw(); }
-            );
-            if (!obj->m_collide_manifolds.empty()) {
-                for (const CF_Manifold& m : obj->m_collide_manifolds)
-                    DrawUI::on_draw_ui.add(
-                        [=]() {obj->ManifoldDraw(m); }
-                    );
-            }
+    // clear ȶ󸲸ǲ¼ٷڴ
+    m_debug_shapes.clear();
+    m_debug_manifolds.clear();
+    m_last_frame_sprites = 0;
+    if (!m_record_only) {
+        last_image_id = CF_PREMADE_ID_RANGE_LO - 1;
+        s_pending_sprites.clear();
+        s_pending_sprites.reserve(kSpriteChunkSize);
+    }
+
+    // Ͱ Register/OnDepthChanged άֻдʧЧĿעıȣʱѹ֮˳Ա
+    if (m_stale_items > 0) CompactBuckets();
+    for (const DepthBucket& bucket : m_buckets) {
+        for (const BucketItem& item : bucket.items) {
+            BaseObject* obj = m_slots[item.slot].owner;
+            if (obj->IsVisible()) {
+                if (const TileLayer* tiles = obj->as_tile_layer()) {
+                    // ģʽʵӼ޴봰еͳһ
+                    m_last_frame_sprites += tiles->SolidCellCount();
+                    if (m_record_only) continue;
+                    RecordDebugOverlay(obj);
+                    PushTileLayer(*tiles);
+                    continue;
+                }
+                if (obj->m_sprite_update_freq > 0 &&
+                    g_frame_count - obj->m_sprite_last_update_frame >= obj->m_sprite_update_freq)
+                {
+                    obj->m_sprite_last_update_frame = g_frame_count;
+                    obj->m_sprite_current_frame_index = (obj->m_sprite_current_frame_index + 1) % obj->m_sprite_vertical_frame_count;
+                }
+                ++m_last_frame_sprites;
+                // ¼ģʽ޴ģ⣩ֻƽ֡Ⱦ
+                if (m_record_only) continue;
+
+                RecordDebugOverlay(obj);
+                CF_Sprite& sprite = obj->GetSprite();
+
+                // ˢ¶
+                cf_sprite_update(&sprite);
+
+                // ʹöλø transform
+                CF_V2 pos = obj->GetPosition();
+                sprite.transform.p = pos;
 
-            if (obj->m_sprite_update_freq > 0 &&
-                g_frame_count - obj->m_sprite_last_update_frame >= obj->m_sprite_update_freq)
-            {
-                obj->m_sprite_last_update_frame = g_frame_count;
-                obj->m_sprite_current_frame_index = (obj->m_sprite_current_frame_index + 1) % obj->m_sprite_vertical_frame_count;
+                //  sprite Ŀ
+                PushFrameSprite(&sprite, obj->m_sprite_current_frame_index, obj->m_sprite_vertical_frame_count);
             }
-            //  sprite Ŀ
-            PushFrameSprite(&sprite, obj->m_sprite_current_frame_index, obj->m_sprite_vertical_frame_count);
         }
     }
 
     // ֡ĩȷʣĿύ
-    FlushPendingSprites();
+    if (!m_record_only) FlushPendingSprites();
 }
 
 size_t DrawingSequence::GetEstimatedMemoryUsageBytes() const noexcept
 {
     size_t total = 0;
-    total += m_entries.capacity() * sizeof(std::unique_ptr<Entry>);
-    total += m_entries.size() * sizeof(Entry);
+    total += m_slots.capacity() * sizeof(Entry);
+    total += m_free_slots.capacity() * sizeof(uint32_t);
+    total += m_buckets.capacity() * sizeof(DepthBucket);
+    for (const DepthBucket& bucket : m_buckets) total += bucket.items.capacity() * sizeof(BucketItem);
+    total += m_debug_shapes.capacity() * sizeof(CF_ShapeWrapper);
+    total += m_debug_manifolds.capacity() * sizeof(CF_Manifold);
     return total;
 }
@@ -97,10 +97,12 @@ bool PersistRespawnRecordToDisk(bool has_record, const std::string& room_name, C
 // ҵǰ
 void GlobalPlayer::Respawn() {
 	if (respawn_room != RoomLoader::Instance().GetCurrentRoom()) {
-		OUTPUT({ "GlobalPlayer::Respawn" }, "Warning: Respawning in a different room without loading it.");
+		LOG_WARN(Player, { "GlobalPlayer::Respawn" }, "Warning: Respawning in a different room without loading it.");
 	}
 	if (!ObjManager::Instance().TryGetRegisteration(player_token)) {
 		player_token = ObjManager::Instance().Create<PlayerObject>(respawn_point);
+		// Ҳڷգԭʱ Revive ´
+		ObjManager::Instance().ExcludeFromRoomSnapshot(player_token);
 	}
 	else {
 		ObjManager::Instance()[player_token].SetPosition(respawn_point);
@@ -112,6 +114,7 @@ void GlobalPlayer::Emerge() {
 	if (!emerge_pos.need_emerge) Respawn();
 	else if (!ObjManager::Instance().TryGetRegisteration(player_token)) {
 		player_token = ObjManager::Instance().Create<PlayerObject>(emerge_pos.position);
+		ObjManager::Instance().ExcludeFromRoomSnapshot(player_token);
 	}
 	else {
 		ObjManager::Instance()[player_token].SetPosition(emerge_pos.position);
@@ -119,6 +122,16 @@ void GlobalPlayer::Emerge() {
 	emerge_pos.need_emerge = false;
 }
 
+//  R ԭػָǰ䣨ֻؽ״̬ıĶ󣩣޷ָʱ˻¼
+void GlobalPlayer::Revive() {
+	if (!respawn_room) return;
+	if (RoomLoader::Instance().Restore(*respawn_room)) {
+		Emerge();
+		return;
+	}
+	RoomLoader::Instance().Load(*respawn_room);
+}
+
 // ЧѪٵǰʵ
 void GlobalPlayer::Hurt() {
 	if (!objs.TryGetRegisteration(player_token)) return;
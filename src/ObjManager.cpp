@@ -1,20 +1,104 @@
 #include "obj_manager.h"
 #include "base_object.h" // 提供 BaseObject 声明
 #include <typeinfo>
+#include <algorithm>
 #include <cstdint>
 #include <stdexcept>
 #include <cstddef>
 
 #include "debug_config.h"
+#include "drawing_sequence.h"
+#include "profiler.h"
+#include "room_snapshot.h"
+
+namespace {
+    // 为哈希表预留到至少 need 个元素；不足时至少翻倍，避免多次小批量预留退化为每批一次 rehash
+    template <typename Map>
+    void ReserveMap(Map& m, size_t need)
+    {
+        if (static_cast<float>(need) <= m.max_load_factor() * static_cast<float>(m.bucket_count())) return;
+        m.reserve(std::max(need, m.size() * 2));
+    }
+}
 
 ObjManager::ObjManager() noexcept = default;
 
 ObjManager::~ObjManager() noexcept
 {
-    // 析构时依赖 unique_ptr 自动释放管理的对象资源
+    // 析构时依赖 unique_ptr 自动把对象归还到各自的池，随后池本身释放
     // 注意：析构前应确保外部不再使用 ObjManager（单例析构顺序依赖）
 }
 
+ObjectPoolBase* ObjManager::RegisterPool(std::unique_ptr<ObjectPoolBase> pool)
+{
+    pools_.push_back(std::move(pool));
+    return pools_.back().get();
+}
+
+void ObjManager::ReserveCreates(size_t n)
+{
+    if (pending_creates_.size() + n > pending_creates_.capacity())
+        pending_creates_.reserve(std::max(pending_creates_.size() + n, pending_creates_.capacity() * 2));
+    if (n > free_pending_slots_.size()) {
+        const size_t need = pending_slots_.size() + (n - free_pending_slots_.size());
+        if (need > pending_slots_.capacity()) pending_slots_.reserve(std::max(need, pending_slots_.capacity() * 2));
+    }
+    if (room_scope_depth_ > 0 && room_snapshot_) {
+        auto& entries = room_snapshot_->entries;
+        if (entries.size() + n > entries.capacity()) entries.reserve(std::max(entries.size() + n, entries.capacity() * 2));
+    }
+    DrawingSequence::Instance().Reserve(n);
+}
+
+uint32_t ObjManager::AcquirePendingSlot()
+{
+    uint32_t slot;
+    if (!free_pending_slots_.empty()) {
+        slot = free_pending_slots_.back();
+        free_pending_slots_.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(pending_slots_.size());
+        pending_slots_.emplace_back();
+    }
+    pending_slots_[slot].in_use = true;
+    return slot;
+}
+
+void ObjManager::ReleasePendingSlot(uint32_t slot) noexcept
+{
+    if (slot >= pending_slots_.size() || !pending_slots_[slot].in_use) return;
+    PendingSlot& ps = pending_slots_[slot];
+    ps.in_use = false;
+    ps.real = ObjToken::Invalid();
+    ps.create_pos = kNoPendingSlot;
+    // 代数递增（保持偶数）：仍持有该槽位旧 pending token 的调用方从此解析失败，不会指向复用该槽位的新对象
+    ps.generation += kPendingGenerationStep;
+    free_pending_slots_.push_back(slot);
+}
+
+const ObjManager::PendingSlot* ObjManager::FindPendingSlot(const ObjToken& token) const noexcept
+{
+    if (token.isRegitsered || token.index >= pending_slots_.size()) return nullptr;
+    const PendingSlot& ps = pending_slots_[token.index];
+    if (!ps.in_use || ps.generation != token.generation) return nullptr;
+    return &ps;
+}
+
+BaseObject* ObjManager::FindPendingObject(const ObjToken& token) const noexcept
+{
+    const PendingSlot* ps = FindPendingSlot(token);
+    if (!ps || ps->create_pos == kNoPendingSlot) return nullptr;
+    return pending_creates_[ps->create_pos].ptr.get();
+}
+
+size_t ObjManager::TrimPools() noexcept
+{
+    size_t released = 0;
+    for (auto& pool : pools_) released += pool->Trim();
+    return released;
+}
+
 ObjManager & ObjManager::Instance() noexcept
 {
     static ObjManager inst;
@@ -28,13 +112,13 @@ bool ObjManager::IsValid(const ObjToken& token) const noexcept
     return e.alive && (e.generation == token.generation) && e.ptr;
 }
 
-// 将 unique_ptr<BaseObject> 纳入管理并立即启动（Start），但不直接扩展 objects_；
+// 将池中分配的对象纳入管理并立即启动（Start），但不直接扩展 objects_；
 // 对象被放入 pending_creates_，在 UpdateAll 的提交阶段合并到 objects_（安全点）。
-// 返回的 token.index 为 pending id（非真实 objects_ 索引），调用方应使用 TryGetRegisteration 查验或等待下一帧提交。
-ObjManager::ObjToken ObjManager::CreateEntry(std::unique_ptr<BaseObject> obj)
+// 返回的 token 指向 pending 解析表的槽位（非真实 objects_ 索引），调用方应使用 TryGetRegisteration 查验或等待下一帧提交。
+ObjManager::ObjToken ObjManager::CreateEntry(ObjectPtr obj)
 {
     if (!obj) {
-        OUTPUT({"ObjManager"}, "CreateEntry: factory returned nullptr");
+        LOG_WARN(ObjManager, "CreateEntry: factory returned nullptr");
         return ObjToken::Invalid();
     }   
 
@@ -45,21 +129,22 @@ ObjManager::ObjToken ObjManager::CreateEntry(std::unique_ptr<BaseObject> obj)
         raw->Start();
     }
     catch (...) {
-        OUTPUT({"ObjManager"}, "CreateEntry: Start() threw for object at", static_cast<const void*>(raw), "(pending)");
+        LOG_WARN(ObjManager, "CreateEntry: Start() threw for object at", static_cast<const void*>(raw), "(pending)");
         return ObjToken::Invalid();
     }
 
-    // 分配 pending id 并将对象放入 pending 创建区；此时不向 objects_ 添加条目以避免在更新循环中触发 vector 重分配导致迭代器失效。
-    uint32_t pid = next_pending_id_++;
-    pending_creates_.emplace(pid, PendingCreate{ std::move(obj) });
-    pending_ptr_to_id_.emplace(raw, pid);
+    // 占用 pending 槽位并把对象追加到 pending 创建区；此时不向 objects_ 添加条目以避免在更新循环中触发 vector 重分配导致迭代器失效。
+    uint32_t slot = AcquirePendingSlot();
+    pending_slots_[slot].create_pos = static_cast<uint32_t>(pending_creates_.size());
+    pending_creates_.push_back(PendingCreate{ std::move(obj), slot });
     ++alive_count_;
 
-    OUTPUT({"ObjManager"}, "CreateEntry: created pending object at", static_cast<const void*>(raw),
-        " (pending id =", pid, ", commit next-frame)");
+    LOG_TRACE(ObjManager, "CreateEntry: created pending object at", static_cast<const void*>(raw),
+        " (pending slot =", slot, ", commit next-frame)");
 
     ObjToken token;
-    token.index = pid;
+    token.index = slot;
+    token.generation = pending_slots_[slot].generation;
 	token.isRegitsered = false;
     return token;
 }
@@ -73,7 +158,7 @@ void ObjManager::DestroyEntry(uint32_t index) noexcept
     if (!e.alive || !e.ptr) return;
 
     BaseObject* raw = e.ptr.get();
-    OUTPUT({"ObjManager"}, "DestroyEntry: destroying object at",
+    LOG_TRACE(ObjManager, "DestroyEntry: destroying object at",
         static_cast<const void*>(raw), "(type:", typeid(*raw).name(), ", index =", index,
         ", gen =", e.generation, ")");
 
@@ -90,7 +175,7 @@ void ObjManager::DestroyEntry(uint32_t index) noexcept
     // 将对象的 token 设为 Invalid，避免悬挂句柄
     e.ptr->SetObjToken(ObjToken::Invalid());
 
-    // 释放 unique_ptr 并标记 slot 可复用
+    // 析构对象并把存储归还给所属类型的池，标记 slot 可复用
     e.ptr.reset();
     e.alive = false;
     e.skip_update_this_frame = false;
@@ -98,16 +183,9 @@ void ObjManager::DestroyEntry(uint32_t index) noexcept
     // 增加 generation 使旧 token 失效（保证安全回收）
     ++e.generation;
 
-    // 修复：清理 pending -> real 映射时，需同时检查 index 和 generation
-    for (auto it = pending_to_real_map_.begin(); it != pending_to_real_map_.end(); ) {
-        if (it->second.index == index && it->second.generation == (e.generation - 1)) {
-            OUTPUT({"ObjManager"}, "DestroyEntry: removing pending_to_real_map_ entry for pending id =",
-                      it->first, "-> index=", index, ", gen=", (e.generation - 1));
-            it = pending_to_real_map_.erase(it);
-        } else {
-            ++it;
-        }
-    }
+    // 释放创建时占用的 pending 槽位（O(1)，旧的 pending token 随之失效）
+    ReleasePendingSlot(e.pending_slot);
+    e.pending_slot = kNoPendingSlot;
 
     free_indices_.push_back(index);
 
@@ -117,12 +195,12 @@ void ObjManager::DestroyEntry(uint32_t index) noexcept
 void ObjManager::DestroyExisting(const ObjToken& token) noexcept
 {
     if (token.index >= objects_.size()) {
-        OUTPUT({"ObjManager"}, "DestroyExisting(token): invalid index", token.index);
+        LOG_WARN(ObjManager, "DestroyExisting(token): invalid index", token.index);
         return;
     }
     const Entry& e = objects_[token.index];
     if (!e.alive || e.generation != token.generation) {
-        OUTPUT({"ObjManager"}, "DestroyExisting(token): token invalid or object not alive (index =",
+        LOG_WARN(ObjManager, "DestroyExisting(token): token invalid or object not alive (index =",
             token.index, ", gen=", token.generation, ")");
         return;
     }
@@ -131,11 +209,11 @@ void ObjManager::DestroyExisting(const ObjToken& token) noexcept
     uint64_t key = (static_cast<uint64_t>(token.index) << 32) | token.generation;
     if (pending_destroy_set_.insert(key).second) {
         pending_destroys_.push_back(token);
-        OUTPUT({"ObjManager"}, "DestroyExisting: enqueued destroy for index =", token.index,
+        LOG_TRACE(ObjManager, "DestroyExisting: enqueued destroy for index =", token.index,
             " gen=", token.generation);
     }
     else {
-        OUTPUT({"ObjManager"}, "DestroyExisting: already enqueued for index =", token.index,
+        LOG_TRACE(ObjManager, "DestroyExisting: already enqueued for index =", token.index,
             " gen=", token.generation);
     }
 }
@@ -143,21 +221,21 @@ void ObjManager::DestroyExisting(const ObjToken& token) noexcept
 // 如果传入的 token 对应 pending 对象且尚未被合并为真实 token，则直接销毁 pending 记录并调用 OnDestroy
 void ObjManager::DestroyPending(const ObjToken& p) noexcept
 {
-    if (!p.isValid()) return;
-    if (TryGetRegisteration(p)) return;
+    const PendingSlot* ps = FindPendingSlot(p);
+    if (!ps || ps->create_pos == kNoPendingSlot) return;
 
-    auto it = pending_creates_.find(p.index);
-    if (it == pending_creates_.end()) return;
-    BaseObject* raw = it->second.ptr.get();
+    PendingCreate& pc = pending_creates_[ps->create_pos];
+    BaseObject* raw = pc.ptr.get();
+    if (!raw) return;
     // 调用 OnDestroy 让对象清理自身资源
-    it->second.ptr->OnDestroy();
+    raw->OnDestroy();
     // 若意外存在 token，置为 Invalid（通常 pending 对象尚未被赋 token）
-    it->second.ptr->SetObjToken(ObjToken::Invalid());
-    // 移除 pending 记录
-    pending_creates_.erase(it);
-    pending_ptr_to_id_.erase(raw);
+    raw->SetObjToken(ObjToken::Invalid());
+    // 析构对象；pending_creates_ 中留下空条目，提交时跳过（保持其余条目的下标与创建顺序不变）
+    pc.ptr.reset();
+    ReleasePendingSlot(pc.slot);
     if (alive_count_ > 0) --alive_count_;
-    OUTPUT({"ObjManager"}, "DestroyPending: destroyed pending id =", p.index, "at", static_cast<const void*>(raw));
+    LOG_TRACE(ObjManager, "DestroyPending: destroyed pending slot =", p.index, "at", static_cast<const void*>(raw));
 }
 
 // 高层销毁入口：根据传入 token 判定是 pending 还是已注册 token，然后选择合适的路径
@@ -176,91 +254,103 @@ void ObjManager::Destroy(const ObjToken& p) noexcept
 
 void ObjManager::DestroyAll() noexcept
 {
-    OUTPUT({"ObjManager"}, "DestroyAll: destroying all objects (", alive_count_, ")");
+    LOG_INFO(ObjManager, "DestroyAll: destroying all objects (", alive_count_, ")");
 
     // 清理所有挂起的创建/销毁队列（先清理 pending 表，避免后续提交）
     pending_destroys_.clear();
     pending_destroy_set_.clear();
     pending_creates_.clear();
-    pending_ptr_to_id_.clear();
-    pending_to_real_map_.clear();
+    // 逐个释放而不是清空解析表：代数保留，旧房间残留的 pending token 不会解析到新房间的对象
+    for (uint32_t slot = 0; slot < pending_slots_.size(); ++slot) ReleasePendingSlot(slot);
 
-    // 先从物理系统统一反注册所有仍然存活的对象
-    for (uint32_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
-        if (e.alive && e.ptr) {
-            PhysicsSystem::Instance().Unregister(ObjToken{ i, e.generation });
-        }
-    }
+    // 绘制序列与物理系统整体清空（各对象析构时的 Unregister 随之变为空操作）
+    DrawingSequence::Instance().UnregisterAll();
+    PhysicsSystem::Instance().UnregisterAll();
 
-    // 调用 OnDestroy 并彻底释放所有对象资源，使 token 失效
-    for (uint32_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
+    // 先为所有对象调用 OnDestroy 并使 token 失效，再统一析构（对象的 OnDestroy 仍可访问其它对象）
+    for (Entry& e : objects_) {
         if (e.alive && e.ptr) {
             e.ptr->OnDestroy();
-            // 置 token 为 Invalid
             e.ptr->SetObjToken(ObjToken::Invalid());
-            object_index_map_.erase(e.ptr.get());
-            e.ptr.reset();
-            e.alive = false;
-            e.skip_update_this_frame = false;
-            ++e.generation; // 使旧 token 失效
-            free_indices_.push_back(i);
         }
     }
+    // 析构对象：池中的对象归还槽位，arena 中的对象只运行析构
+    for (Entry& e : objects_) e.ptr.reset();
 
     // 清理容器，重置计数
     objects_.clear();
     free_indices_.clear();
     object_index_map_.clear();
     alive_count_ = 0;
+
+    // 全部对象已析构，房间 arena 一次性重置；快照随房间一起作废
+    room_arena_.Reset();
+    if (room_snapshot_) {
+        room_snapshot_->entries.clear();
+        room_snapshot_->captured = false;
+    }
 }
 
 void ObjManager::UpdateAll() noexcept
 {
+    PROFILE_ZONE("ObjManager::UpdateAll");
     // 1) 应用物理更新：为每个活跃对象调用 FrameEnterApply()
     // 使用索引遍历以避免持有范围 for 中的引用而在并发修改/重分配时失效
-    for (size_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
-        if (e.alive && e.ptr && !e.skip_update_this_frame) { 
-            e.ptr->FrameEnterApply(); 
+    {
+        PROFILE_ZONE("FrameEnterApply");
+        for (size_t i = 0; i < objects_.size(); ++i) {
+            Entry& e = objects_[i];
+            if (e.alive && e.ptr && !e.skip_update_this_frame) { 
+                e.ptr->FrameEnterApply(); 
+            }
         }
     }
 
     // 2) 全局碰撞检测与回调（PhysicsSystem::Step 会触发对象的碰撞回调）
-    PhysicsSystem::Instance().Step();
+    {
+        PROFILE_ZONE("PhysicsSystem::Step");
+        PhysicsSystem::Instance().Step();
+    }
 
-    // 3) 每帧为活跃对象调用 Update()
-    for (size_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
-        if (e.alive && e.ptr && !e.skip_update_this_frame) { 
-            e.ptr->Update(); 
+    // 3) 每帧为活跃对象调用 Update()（分析器开启时按对象类型记录每次 Update 的耗时）
+    {
+        PROFILE_ZONE("Update");
+        for (size_t i = 0; i < objects_.size(); ++i) {
+            Entry& e = objects_[i];
+            if (e.alive && e.ptr && !e.skip_update_this_frame) { 
+                PROFILE_ZONE(typeid(*e.ptr).name());
+                e.ptr->Update(); 
+            }
         }
     }
 
 	// 4) 帧尾应用：为每个活跃对象调用 FrameExitApply()
-    for (size_t i = 0; i < objects_.size(); ++i) {
-        Entry& e = objects_[i];
-        if (e.alive && e.ptr && !e.skip_update_this_frame) {
-            e.ptr->FrameExitApply();
+    {
+        PROFILE_ZONE("FrameExitApply");
+        for (size_t i = 0; i < objects_.size(); ++i) {
+            Entry& e = objects_[i];
+            if (e.alive && e.ptr && !e.skip_update_this_frame) {
+                e.ptr->FrameExitApply();
+            }
         }
     }
 
     // 5) 执行延迟销毁队列（在更新循环安全点处理）
     if (!pending_destroys_.empty()) {
+        PROFILE_ZONE("DestroyPending");
         for (const ObjToken& token : pending_destroys_) {
             if (token.index >= objects_.size()) {
-                OUTPUT({"ObjManager"}, "UpdateAll: pending destroy invalid index", token.index);
+                LOG_WARN(ObjManager, "UpdateAll: pending destroy invalid index", token.index);
                 continue;
             }
             Entry& e = objects_[token.index];
             if (!e.alive || e.generation != token.generation) {
-                OUTPUT({"ObjManager"}, "UpdateAll: pending destroy target not found or token mismatch (index =",
+                LOG_WARN(ObjManager, "UpdateAll: pending destroy target not found or token mismatch (index =",
                     token.index, ", gen=", token.generation, ")");
                 continue;
             }
 
-            OUTPUT({"ObjManager"}, "UpdateAll: executing destroy for object at index =", token.index,
+            LOG_TRACE(ObjManager, "UpdateAll: executing destroy for object at index =", token.index,
                 " gen =", token.generation, " (type: ", typeid(*e.ptr).name(), ")");
 
             // 释放该 slot
@@ -274,22 +364,25 @@ void ObjManager::UpdateAll() noexcept
     // 6) 提交本帧 pending 的创建：在安全点把 pending_creates_ 合并到 objects_ 并注册物理系统，
     //    使其在下一帧参与 FrameEnterApply / Update / 物理处理。
     if (!pending_creates_.empty()) {
+        PROFILE_ZONE("CommitPending");
         // 预留容量以避免在合并过程中发生多次重分配
         objects_.reserve(objects_.size() + pending_creates_.size());
 
-        // 收集 pending id 列表，避免在循环中修改 unordered_map 导致迭代问题
-        std::vector<uint32_t> pids;
-        pids.reserve(pending_creates_.size());
-        for (const auto &kv : pending_creates_) pids.push_back(kv.first);
-
-        for (uint32_t pid : pids) {
-            auto it = pending_creates_.find(pid);
-            if (it == pending_creates_.end()) continue;
-            PendingCreate &pc = it->second;
-            if (!pc.ptr) {
-                pending_creates_.erase(it);
-                continue;
-            }
+        // 统计静态对象数，为物理表整批预留
+        size_t live_count = 0;
+        size_t static_count = 0;
+        for (const PendingCreate& pc : pending_creates_) {
+            if (!pc.ptr) continue;
+            ++live_count;
+            if (pc.ptr->IsStatic()) ++static_count;
+        }
+        ReserveMap(object_index_map_, object_index_map_.size() + live_count);
+        PhysicsSystem::Instance().Reserve(live_count - static_count, static_count);
+
+        // pending_creates_ 即创建顺序：同一批创建的对象在 objects_ 与物理表中连续排列
+        for (size_t i = 0; i < pending_creates_.size(); ++i) {
+            PendingCreate &pc = pending_creates_[i];
+            if (!pc.ptr) continue; // pending 阶段已被销毁
 
             BaseObject* raw = pc.ptr.get();
             uint32_t index = 0;
@@ -312,6 +405,7 @@ void ObjManager::UpdateAll() noexcept
                 ++e.generation;
                 e.skip_update_this_frame = false;
             }
+            objects_[index].pending_slot = pc.slot;
 
             // 注册索引映射并注册到物理系统
             object_index_map_[raw] = index;
@@ -323,18 +417,16 @@ void ObjManager::UpdateAll() noexcept
                 objects_[index].ptr->SetObjToken(tok);
             }
 
-            // 记录 pending -> real 的映射，便于 ResolvePending
-            pending_to_real_map_.emplace(pid, tok);
-
-            // 从 pending_ptr_to_id_ 中移除
-            pending_ptr_to_id_.erase(raw);
+            // pending 槽位改为记录真实 token，持有 pending token 的调用方由此解析
+            PendingSlot& ps = pending_slots_[pc.slot];
+            ps.real = tok;
+            ps.create_pos = kNoPendingSlot;
 
-            OUTPUT({"ObjManager"}, "UpdateAll: committed pending object at", static_cast<const void*>(raw),
-                " (type: ", typeid(*objects_[index].ptr).name(), ", pending id =", pid, ", index =", index, ", gen =", objects_[index].generation, ")");
-
-            // 从 pending_creates_ 中移除该条目
-            pending_creates_.erase(it);
+            LOG_TRACE(ObjManager, "UpdateAll: committed pending object at", static_cast<const void*>(raw),
+                " (type: ", typeid(*objects_[index].ptr).name(), ", pending slot =", pc.slot, ", index =", index, ", gen =", objects_[index].generation, ")");
         }
+        // 清空创建区但保留容量，下一帧的创建不再分配
+        pending_creates_.clear();
     }
     
 }
@@ -358,10 +450,10 @@ bool ObjManager::TryGetRegisteration(ObjToken& token) const noexcept
         return false;
     }
 
-    // 尚未标记为 registered：检查 pending -> real 映射表
-    auto it = pending_to_real_map_.find(token.index);
-    if (it != pending_to_real_map_.end()) {
-        token = it->second;
+    // 尚未标记为 registered：通过 pending 槽位查找提交后的真实 token（槽位代数不符说明 token 已过期）
+    const PendingSlot* ps = FindPendingSlot(token);
+    if (ps && ps->real.isValid()) {
+        token = ps->real;
         return true;
     }
     return false;
@@ -378,10 +470,9 @@ bool ObjManager::TryGetRegisteration(const ObjToken& token) const noexcept
         return false;
     }
 
-    // 尚未标记为 registered：检查 pending -> real 映射表（只检查，不修改）
-    auto it = pending_to_real_map_.find(token.index);
-    if (it != pending_to_real_map_.end()) return true;
-    return false;
+    // 尚未标记为 registered：检查 pending 槽位是否已记录真实 token（只检查，不修改）
+    const PendingSlot* ps = FindPendingSlot(token);
+    return ps && ps->real.isValid();
 }
 
 // operator[] 实现，若 token 为 pending，则尝试转换为真实 token或直接访问 pending 对象
@@ -391,15 +482,14 @@ bool ObjManager::TryGetRegisteration(const ObjToken& token) const noexcept
 BaseObject& ObjManager::operator[](ObjToken& token)
 {
     if (!token.isRegitsered) {
-		auto it = pending_creates_.find(token.index);
-        if (it != pending_creates_.end()) {
-			BaseObject* raw = it->second.ptr.get();
-			OUTPUT({"ObjManager"}, "operator[]: accessing pending object at", static_cast<const void*>(raw));
+		BaseObject* raw = FindPendingObject(token);
+        if (raw) {
+			LOG_TRACE(ObjManager, "operator[]: accessing pending object at", static_cast<const void*>(raw));
 			return *raw;
         }
         // 尝试使用 TryGetRegisteration 更新 token（若 pending 已被提交）
         TryGetRegisteration(token);
-		OUTPUT({"ObjManager"}, "operator[]: checked pending token, updating token to the registered version");
+		LOG_TRACE(ObjManager, "operator[]: checked pending token, updating token to the registered version");
     }
 	return this->operator[](static_cast<const ObjToken&>(token));
 }
@@ -408,12 +498,12 @@ BaseObject& ObjManager::operator[](ObjToken& token)
 BaseObject& ObjManager::operator[](const ObjToken& token)
 {
     if (token.index >= objects_.size()) {
-        OUTPUT({"ObjManager"}, "operator[]: invalid index", token.index);
+        LOG_WARN(ObjManager, "operator[]: invalid index", token.index);
         throw std::out_of_range("ObjManager::operator[]: invalid index");
     }
     Entry& e = objects_[token.index];
     if (!e.alive || e.generation != token.generation || !e.ptr) {
-        OUTPUT({"ObjManager"}, "operator[]: token invalid or object not alive (index =", token.index, ", gen =", token.generation, ")");
+        LOG_WARN(ObjManager, "operator[]: token invalid or object not alive (index =", token.index, ", gen =", token.generation, ")");
         throw std::out_of_range("ObjManager::operator[]: token invalid or object not alive");
     }
     return *e.ptr;
@@ -423,15 +513,14 @@ BaseObject& ObjManager::operator[](const ObjToken& token)
 const BaseObject& ObjManager::operator[](ObjToken& token) const
 {
     if (!token.isRegitsered) {
-        auto it = pending_creates_.find(token.index);
-        if (it != pending_creates_.end()) {
-            BaseObject* raw = it->second.ptr.get();
-            OUTPUT({"ObjManager"}, "operator[]: accessing pending object at", static_cast<const void*>(raw));
+        BaseObject* raw = FindPendingObject(token);
+        if (raw) {
+            LOG_TRACE(ObjManager, "operator[]: accessing pending object at", static_cast<const void*>(raw));
             return *raw;
         }
         // 尝试使用 TryGetRegisteration 更新 token（若 pending 已被提交）
 		TryGetRegisteration(token);
-        OUTPUT({"ObjManager"}, "operator[]: checked pending token, updating token to the registered version");
+        LOG_TRACE(ObjManager, "operator[]: checked pending token, updating token to the registered version");
     }
     return this->operator[](static_cast<const ObjToken&>(token));
 }
@@ -439,12 +528,12 @@ const BaseObject& ObjManager::operator[](ObjToken& token) const
 const BaseObject& ObjManager::operator[](const ObjToken& token) const
 {
     if (token.index >= objects_.size()) {
-        OUTPUT({"ObjManager"}, "operator[] const: invalid index ", token.index);
+        LOG_WARN(ObjManager, "operator[] const: invalid index ", token.index);
         throw std::out_of_range("ObjManager::operator[] const: invalid index");
     }
     const Entry& e = objects_[token.index];
     if (!e.alive || e.generation != token.generation || !e.ptr) {
-        OUTPUT({"ObjManager"}, "operator[] const: token invalid or object not alive (index =", token.index, ", gen =", token.generation, ")");
+        LOG_WARN(ObjManager, "operator[] const: token invalid or object not alive (index =", token.index, ", gen =", token.generation, ")");
         throw std::out_of_range("ObjManager::operator[] const: token invalid or object not alive");
     }
     return *e.ptr;
@@ -457,9 +546,11 @@ size_t ObjManager::GetEstimatedMemoryUsageBytes() const noexcept
     total += free_indices_.capacity() * sizeof(uint32_t);
     total += pending_destroys_.capacity() * sizeof(ObjToken);
     total += pending_destroy_set_.bucket_count() * sizeof(decltype(pending_destroy_set_)::value_type);
-    total += pending_creates_.bucket_count() * sizeof(decltype(pending_creates_)::value_type);
-    total += pending_ptr_to_id_.bucket_count() * sizeof(decltype(pending_ptr_to_id_)::value_type);
-    total += pending_to_real_map_.bucket_count() * sizeof(decltype(pending_to_real_map_)::value_type);
+    total += pending_creates_.capacity() * sizeof(PendingCreate);
+    total += pending_slots_.capacity() * sizeof(PendingSlot);
+    total += free_pending_slots_.capacity() * sizeof(uint32_t);
     total += object_index_map_.bucket_count() * sizeof(decltype(object_index_map_)::value_type);
+    for (const auto& pool : pools_) total += pool->ReservedBytes();
+    total += room_arena_.ReservedBytes();
     return total;
 }
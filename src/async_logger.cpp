@@ -0,0 +1,251 @@
+#include "async_logger.h"
+
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+    constexpr size_t kBatchMax = 256;
+    constexpr auto kIdleWait = std::chrono::milliseconds(5);
+
+    // 静态析构期间 Instance() 已失效，用一个平凡析构的标志判断
+    std::atomic<bool> g_logger_destroyed{ false };
+
+    std::tm LocalTime(std::time_t time)
+    {
+        std::tm tm{};
+#if defined(_WIN32)
+        localtime_s(&tm, &time);
+#else
+        localtime_r(&time, &tm);
+#endif
+        return tm;
+    }
+
+    std::string FormatSessionLabel()
+    {
+        const std::tm tm = LocalTime(std::chrono::system_clock::to_time_t(std::chrono::system_clock::now()));
+        std::ostringstream oss;
+        oss << std::setfill('0')
+            << std::setw(4) << (tm.tm_year + 1900)
+            << std::setw(2) << (tm.tm_mon + 1)
+            << std::setw(2) << tm.tm_mday << '_'
+            << std::setw(2) << tm.tm_hour
+            << std::setw(2) << tm.tm_min;
+        return oss.str();
+    }
+
+    std::ofstream& GetLogFile()
+    {
+        static std::ofstream file;
+        static std::once_flag init_flag;
+        std::call_once(init_flag, []() {
+            std::error_code ec;
+            std::filesystem::path dir = std::filesystem::current_path() / ".." / ".." / ".." / "reports";
+            std::filesystem::create_directories(dir, ec);
+            if (!ec) {
+                file.open(dir / ("debug_log_" + FormatSessionLabel() + ".txt"), std::ios::app);
+            }
+        });
+        return file;
+    }
+
+    template <typename S>
+    S ReadScalar(const unsigned char* p) noexcept
+    {
+        S v;
+        std::memcpy(&v, p, sizeof(S));
+        return v;
+    }
+}
+
+AsyncLogger& AsyncLogger::Instance() noexcept
+{
+    static AsyncLogger instance;
+    return instance;
+}
+
+AsyncLogger::AsyncLogger()
+    : m_cells(std::make_unique<Cell[]>(kQueueCapacity))
+{
+    static_assert((kQueueCapacity & (kQueueCapacity - 1)) == 0, "kQueueCapacity must be a power of two");
+    for (size_t i = 0; i < kQueueCapacity; ++i) {
+        m_cells[i].seq.store(i, std::memory_order_relaxed);
+    }
+    GetLogFile();
+    m_writer = std::thread([this]() { WriterLoop(); });
+}
+
+AsyncLogger::~AsyncLogger()
+{
+    g_logger_destroyed.store(true, std::memory_order_release);
+    m_stop.store(true, std::memory_order_release);
+    m_wake.notify_one();
+    if (m_writer.joinable()) m_writer.join();
+}
+
+void AsyncLogger::Post(const Record& rec) noexcept
+{
+    if (!g_logger_destroyed.load(std::memory_order_acquire)) {
+        Instance().Submit(rec);
+        return;
+    }
+    try {
+        std::string line;
+        FormatRecord(rec, line);
+        line += '\n';
+        std::cerr << line;
+    }
+    catch (...) {
+    }
+}
+
+// Vyukov 有界队列：每个槽位的 seq 表示其状态，生产者通过 CAS 抢占写入位置，单消费者顺序读取
+bool AsyncLogger::Submit(const Record& rec) noexcept
+{
+    size_t pos = m_enqueue_pos.load(std::memory_order_relaxed);
+    Cell* cell = nullptr;
+    for (;;) {
+        cell = &m_cells[pos & (kQueueCapacity - 1)];
+        const size_t seq = cell->seq.load(std::memory_order_acquire);
+        const intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+        if (diff == 0) {
+            if (m_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+        }
+        else if (diff < 0) {
+            // 队列已满：丢弃，不阻塞调用方
+            m_dropped.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else {
+            pos = m_enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+    // 只拷贝已使用的 payload，短日志不必搬运整条记录
+    Record& dst = cell->rec;
+    dst.wall_ns = rec.wall_ns;
+    std::memcpy(dst.header, rec.header, kHeaderBytes);
+    dst.size = rec.size;
+    dst.argc = rec.argc;
+    dst.truncated = rec.truncated;
+    std::memcpy(dst.payload, rec.payload, rec.size);
+    cell->seq.store(pos + 1, std::memory_order_release);
+    m_submitted.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool AsyncLogger::TryPop(Record& out) noexcept
+{
+    Cell& cell = m_cells[m_dequeue_pos & (kQueueCapacity - 1)];
+    const size_t seq = cell.seq.load(std::memory_order_acquire);
+    if (seq != m_dequeue_pos + 1) return false;
+    out.wall_ns = cell.rec.wall_ns;
+    std::memcpy(out.header, cell.rec.header, kHeaderBytes);
+    out.size = cell.rec.size;
+    out.argc = cell.rec.argc;
+    out.truncated = cell.rec.truncated;
+    std::memcpy(out.payload, cell.rec.payload, cell.rec.size);
+    cell.seq.store(m_dequeue_pos + kQueueCapacity, std::memory_order_release);
+    ++m_dequeue_pos;
+    return true;
+}
+
+void AsyncLogger::Flush() noexcept
+{
+    const uint64_t target = m_submitted.load(std::memory_order_relaxed);
+    m_wake.notify_one();
+    while (m_written.load(std::memory_order_acquire) < target && m_writer.joinable()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+void AsyncLogger::WriterLoop()
+{
+    std::string batch;
+    batch.reserve(kBatchMax * 96);
+    Record rec;
+    for (;;) {
+        batch.clear();
+        size_t n = 0;
+        while (n < kBatchMax && TryPop(rec)) {
+            FormatRecord(rec, batch);
+            batch += '\n';
+            ++n;
+        }
+
+        const uint64_t dropped = m_dropped.load(std::memory_order_relaxed);
+        if (dropped != m_dropped_reported) {
+            RecordBuilder b("Logger");
+            b.Add("queue full, dropped");
+            b.Add(dropped - m_dropped_reported);
+            b.Add("message(s)");
+            FormatRecord(b.Get(), batch);
+            batch += '\n';
+            m_dropped_reported = dropped;
+        }
+
+        if (!batch.empty()) {
+            WriteBatch(batch);
+            m_written.fetch_add(n, std::memory_order_release);
+            continue;
+        }
+        if (m_stop.load(std::memory_order_acquire)) break;
+
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+        m_wake.wait_for(lock, kIdleWait);
+    }
+}
+
+void AsyncLogger::WriteBatch(const std::string& batch)
+{
+    std::ofstream& file = GetLogFile();
+    if (file.is_open()) {
+        file.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+        file.flush();
+    }
+    std::cerr.write(batch.data(), static_cast<std::streamsize>(batch.size()));
+    std::cerr.flush();
+}
+
+// 格式与原同步实现一致：[时`分``秒.毫秒] [Header] arg1 arg2 ...
+void AsyncLogger::FormatRecord(const Record& rec, std::string& out)
+{
+    using namespace std::chrono;
+    const nanoseconds since_epoch(rec.wall_ns);
+    const std::tm tm = LocalTime(system_clock::to_time_t(system_clock::time_point(duration_cast<system_clock::duration>(since_epoch))));
+    const long long ms = duration_cast<milliseconds>(since_epoch).count() % 1000;
+
+    std::ostringstream oss;
+    oss << '[' << std::setfill('0')
+        << std::setw(2) << tm.tm_hour << "`"
+        << std::setw(2) << tm.tm_min << "``"
+        << std::setw(2) << tm.tm_sec << '.'
+        << std::setw(3) << ms << "] " << std::setfill(' ');
+    oss << '[' << rec.header << ']';
+
+    const unsigned char* p = rec.payload;
+    const unsigned char* end = rec.payload + rec.size;
+    for (uint8_t i = 0; i < rec.argc && p < end; ++i) {
+        const ArgTag tag = static_cast<ArgTag>(*p++);
+        oss << ' ';
+        switch (tag) {
+        case ArgTag::I64: oss << ReadScalar<int64_t>(p); p += sizeof(int64_t); break;
+        case ArgTag::U64: oss << ReadScalar<uint64_t>(p); p += sizeof(uint64_t); break;
+        case ArgTag::F64: oss << ReadScalar<double>(p); p += sizeof(double); break;
+        case ArgTag::Bool: oss << static_cast<int>(*p); p += sizeof(uint8_t); break;
+        case ArgTag::Char: oss << static_cast<char>(*p); p += sizeof(char); break;
+        case ArgTag::Ptr: oss << reinterpret_cast<const void*>(ReadScalar<uintptr_t>(p)); p += sizeof(uintptr_t); break;
+        case ArgTag::Str: {
+            const uint16_t n = ReadScalar<uint16_t>(p);
+            p += sizeof(uint16_t);
+            oss.write(reinterpret_cast<const char*>(p), n);
+            p += n;
+            break;
+        }
+        }
+    }
+    if (rec.truncated) oss << "...";
+    out += oss.str();
+}
@@ -1,11 +1,17 @@
 #include "base_object.h"
 #include "drawing_sequence.h" // 在 C++ 文件中引用以便使用 DrawingSequence 接口
+#include "tile_layer.h"
+#include "sprite_cache.h"     // 按路径共享的精灵资源
 #include "cute_sprite.h"      // 包含以使用 CF_Sprite 和相关函数
 #include <iostream>
 #include <cmath>
+#include <algorithm>
+#include <array>
+#include <vector>
 
 // BaseObject 的精灵资源与绘制注册相关逻辑：
-// - SpriteSetSource 在设置新路径时会注册/注销 DrawingSequence 以纳入统一的上传与绘制流程。
+// - SpriteSetSource 在设置新路径时会注册/注销 DrawingSequence 以纳入统一的上传与绘制流程，
+//   图像通过 SpriteCache 按路径共享（同一 PNG 只解码一次）。
 // - TweakColliderWithPivot 用于在用户改变 pivot 时同步调整碰撞形状。
 
 void BaseObject::SpriteSetStats(const std::string& path, int vertical_frame_count, int update_freq, int depth, bool set_shape_aabb) noexcept
@@ -32,8 +38,13 @@ void BaseObject::SpriteSetSource(const std::string& path, int vertical_frame_cou
     // 如果之前有有效的精灵路径，先从绘制序列中注销
     if (!m_sprite_path.empty()) {
         DrawingSequence::Instance().Unregister(this);
-        cf_easy_sprite_unload(&m_sprite);
+        SpriteCache::Instance().Release(m_sprite_path);
     }
+    else if (m_anim_clip >= 0) {
+        // 退出片段模式（片段图像的引用由 m_anim_clips 持有，不在此归还）
+        DrawingSequence::Instance().Unregister(this);
+    }
+    m_anim_clip = -1;
 
     // 更新路径和帧数
     m_sprite_path = path;
@@ -47,12 +58,12 @@ void BaseObject::SpriteSetSource(const std::string& path, int vertical_frame_cou
         return;
     }
 
-    // 始终使用 cf_make_easy_sprite_from_png 加载 PNG 文件。
+    // 通过 SpriteCache 取得共享的 easy sprite（首次使用该路径时才调用 cf_make_easy_sprite_from_png）。
     // cute_sprite 将整个文件加载为单个大图像。
     // 多帧动画的分割逻辑需要由您的渲染器（DrawingSequence）根据 m_sprite_vertical_frame_count 处理。
-    m_sprite = cf_make_easy_sprite_from_png(m_sprite_path.c_str(), nullptr);
+    m_sprite = SpriteCache::Instance().Acquire(m_sprite_path);
     if (!m_sprite.easy_sprite_id) {
-        OUTPUT({ "Sprite" }, "Failed to load sprite:", m_sprite_path.c_str());
+        LOG_WARN(Resource, { "Sprite" }, "Failed to load sprite:", m_sprite_path.c_str());
         m_sprite = cf_sprite_defaults();
         restore_scale();
         m_sprite_path.clear();
@@ -76,11 +87,87 @@ void BaseObject::SpriteSetSource(const std::string& path, int vertical_frame_cou
 	SetPivot(p);
 }
 
+void BaseObject::SetDepth(int d) noexcept
+{
+    if (m_depth == d) return;
+    m_depth = d;
+    DrawingSequence::Instance().OnDepthChanged(this);
+}
+
+// 供 ActSeq（只有 BaseObject 的前向声明）调用
+void MarkObjectStateDiverged(BaseObject* obj) noexcept
+{
+    if (obj) obj->MarkStateDiverged();
+}
+
 void BaseObject::SpriteSetUpdateFreq(int update_freq) noexcept
 {
 	m_sprite_update_freq = update_freq > 0 ? update_freq : 1;
 }
 
+int BaseObject::AddAnimClip(const std::string& name, const std::string& path, int vertical_frame_count, int update_freq) noexcept
+{
+    int existing = FindAnimClip(name);
+    if (existing >= 0) return existing;
+
+    AnimClip clip;
+    clip.name = name;
+    clip.path = path;
+    clip.sprite = SpriteCache::Instance().Acquire(path);
+    clip.vertical_frame_count = vertical_frame_count > 0 ? vertical_frame_count : 1;
+    clip.update_freq = update_freq > 0 ? update_freq : 1;
+    if (!clip.sprite.easy_sprite_id) {
+        LOG_WARN(Resource, { "Sprite" }, "Failed to load anim clip:", name.c_str(), path.c_str());
+        return -1;
+    }
+    m_anim_clips.push_back(std::move(clip));
+    return static_cast<int>(m_anim_clips.size()) - 1;
+}
+
+int BaseObject::FindAnimClip(const std::string& name) const noexcept
+{
+    for (size_t i = 0; i < m_anim_clips.size(); ++i) {
+        if (m_anim_clips[i].name == name) return static_cast<int>(i);
+    }
+    return -1;
+}
+
+void BaseObject::PlayAnimClip(int clip_id, bool restart) noexcept
+{
+    if (clip_id < 0 || clip_id >= static_cast<int>(m_anim_clips.size())) return;
+    if (clip_id == m_anim_clip && !restart) return;
+
+    const bool registered = m_anim_clip >= 0 || !m_sprite_path.empty();
+    if (!m_sprite_path.empty()) {
+        // 从 SpriteSetSource 模式切换过来：归还单一精灵的引用，保持绘制注册
+        SpriteCache::Instance().Release(m_sprite_path);
+        m_sprite_path.clear();
+    }
+
+    const AnimClip& clip = m_anim_clips[clip_id];
+    const bool size_changed = m_sprite.w != clip.sprite.w || SpriteHeight() != clip.sprite.h / clip.vertical_frame_count;
+
+    // 只替换图像与帧参数，scale/offset/transform/opacity 等对象状态保持不变
+    m_sprite.easy_sprite_id = clip.sprite.easy_sprite_id;
+    m_sprite.name = clip.sprite.name;
+    m_sprite.w = clip.sprite.w;
+    m_sprite.h = clip.sprite.h;
+    m_sprite.pivots = clip.sprite.pivots;
+    m_sprite_vertical_frame_count = clip.vertical_frame_count;
+    m_sprite_update_freq = clip.update_freq;
+    m_sprite_current_frame_index = 0;
+    m_anim_clip = clip_id;
+
+    // 帧尺寸变化时按新尺寸重新计算 pivot 像素偏移
+    // （等价于 SpriteSetSource 中 SetPivot(-p)/SetPivot(p) 的净效果：碰撞体不动，只更新 offset 与物理 pivot）
+    if (size_changed) {
+        CF_V2 p = CF_V2{ m_pivot.x * m_sprite.w * 0.5f, m_pivot.y * SpriteHeight() * 0.5f };
+        m_sprite.offset = -p;
+        if (IsColliderApplyPivot()) set_pivot(p);
+    }
+    if (!registered) DrawingSequence::Instance().Register(this);
+}
+
 // 当用户想要将 pivot 应用于碰撞器时，调整本地 shape 以将枢轴偏移应用到形状（便于渲染/碰撞对齐）
 void BaseObject::TweakColliderWithPivot(const CF_V2& pivot) noexcept
 {
@@ -114,8 +201,15 @@ void BaseObject::TweakColliderWithPivot(const CF_V2& pivot) noexcept
 
 bool BaseObject::IsCollidedWith(const BaseObject& other, CF_Manifold& out_m) noexcept
 {
-    CF_ShapeWrapper A = this->GetShape();
-    CF_ShapeWrapper B = other.GetShape();
+    if (const TileLayer* tiles = other.as_tile_layer()) {
+        return tiles->CollideShape(GetShape(), &out_m);
+    }
+    return CollideWithShape(other.GetShape(), out_m);
+}
+
+bool BaseObject::CollideWithShape(const CF_ShapeWrapper& B, CF_Manifold& out_m) const noexcept
+{
+    const CF_ShapeWrapper& A = GetShape();
     bool res = cf_collided(
         &A.u, nullptr, A.type,
         &B.u, nullptr, B.type
@@ -138,6 +232,8 @@ CF_Manifold BaseObject::ExclusionWithSolid(const ObjManager::ObjToken& oth, cons
     if (!oth.isValid() || !objs.IsValid(oth) || v2math::length(m.contact_points[0] - m.contact_points[1]) < 1e-3f) return m;
 
     BaseObject& other = objs[oth];
+    if (m_solid_resolve_mode == SolidResolveMode::Analytic) return ExclusionWithSolidAnalytic(other);
+
     CF_V2 vel = GetVelocity();
     CF_Manifold result = m;
 
@@ -161,6 +257,131 @@ CF_Manifold BaseObject::ExclusionWithSolid(const ObjManager::ObjToken& oth, cons
     return result;
 }
 
+// 解析排斥：
+// - 先以当前位置重新检测一次（同一帧内之前的接触可能已经把对象推出）
+// - AABB-AABB：默认沿最小穿透轴推出；若上一帧位置在两轴上都与对方分离（斜向进入），
+//   则用扫掠 AABB 求出最后进入的轴，只沿该轴推出，另一轴的运动保留（贴墙/贴地滑动）
+// - 其它形状：穿透不是由本帧运动造成时沿 manifold 法线推出；否则用 cf_toi 保守推进求出接触时刻，
+//   退回到接触点后把剩余位移中指向对方的分量去掉
+// - 推出后保留 kSolidContactSkin 的重叠，再检测一次得到最终 manifold
+CF_Manifold BaseObject::ExclusionWithSolidAnalytic(const BaseObject& other) noexcept
+{
+    return ResolveSolidShapeAnalytic(other.GetShape());
+}
+
+CF_Manifold BaseObject::ResolveSolidShapeAnalytic(const CF_ShapeWrapper& B) noexcept
+{
+    CF_Manifold cur{};
+    if (!CollideWithShape(B, cur)) return cur;
+
+    const CF_V2 vel = GetVelocity();
+    const CF_ShapeWrapper A = GetShape();
+
+    if (A.type == CF_SHAPE_TYPE_AABB && B.type == CF_SHAPE_TYPE_AABB) {
+        const CF_Aabb& a = A.u.aabb;
+        const CF_Aabb& b = B.u.aabb;
+        // 当前与上一帧位置（a - vel）在各轴上的重叠量
+        const float ox = std::min(a.max.x, b.max.x) - std::max(a.min.x, b.min.x);
+        const float oy = std::min(a.max.y, b.max.y) - std::max(a.min.y, b.min.y);
+        const float ox0 = std::min(a.max.x - vel.x, b.max.x) - std::max(a.min.x - vel.x, b.min.x);
+        const float oy0 = std::min(a.max.y - vel.y, b.max.y) - std::max(a.min.y - vel.y, b.min.y);
+        // 各轴上由自身指向对方的方向
+        const float dir_x = (a.min.x + a.max.x) <= (b.min.x + b.max.x) ? 1.0f : -1.0f;
+        const float dir_y = (a.min.y + a.max.y) <= (b.min.y + b.max.y) ? 1.0f : -1.0f;
+
+        bool use_x = ox < oy;
+        if (ox0 <= 0.0f && oy0 <= 0.0f) {
+            // 扫掠：进入时刻 = 上一帧的间隙 / 朝向对方的速度分量，取较晚进入的轴
+            const float vx = vel.x * dir_x;
+            const float vy = vel.y * dir_y;
+            const float tx = vx > 0.0f ? -ox0 / vx : -1.0f;
+            const float ty = vy > 0.0f ? -oy0 / vy : -1.0f;
+            if (tx >= 0.0f || ty >= 0.0f) use_x = tx > ty;
+        }
+
+        CF_V2 pos = GetPosition();
+        if (use_x) {
+            if (ox > kSolidContactSkin) pos.x -= dir_x * (ox - kSolidContactSkin);
+        }
+        else {
+            if (oy > kSolidContactSkin) pos.y -= dir_y * (oy - kSolidContactSkin);
+        }
+        SetPosition(pos);
+    }
+    else {
+        const float depth = cur.count == 2 ? std::max(cur.depths[0], cur.depths[1]) : cur.depths[0];
+        const float into = v2math::dot(vel, cur.n);
+        bool resolved = false;
+        if (into > 1e-3f && depth - into <= 1e-3f) {
+            // 穿透完全来自本帧运动：从上一帧位置做保守推进
+            CF_Transform ax = cf_make_transform();
+            ax.p = -vel;
+            CF_ToiResult toi = cf_toi(&A.u, A.type, &ax, vel, &B.u, B.type, nullptr, cf_v2(0.0f, 0.0f), 1);
+            if (toi.hit && toi.toi > 0.0f && toi.toi <= 1.0f) {
+                CF_V2 n = v2math::normalized(toi.n);
+                if (v2math::dot(n, cur.n) < 0.0f) n = -n;
+                CF_V2 rest = vel * (1.0f - toi.toi);
+                const float rn = v2math::dot(rest, n);
+                if (rn > 0.0f) rest -= n * rn;
+                SetPosition(GetPosition() - vel * (1.0f - toi.toi) + rest + n * kSolidContactSkin);
+                resolved = true;
+            }
+        }
+        if (!resolved && depth > kSolidContactSkin) {
+            SetPosition(GetPosition() - cur.n * (depth - kSolidContactSkin));
+        }
+    }
+
+    CF_Manifold result{};
+    CollideWithShape(B, result);
+    return result;
+}
+
+// 与 TileLayer 排斥：
+// - 收集与自身 AABB 重叠的实体格子，按重叠面积从大到小排序（先解决"脚下"的主要接触，
+//   相邻格子的接缝通常会在此之后不再重叠，从而避免在平整地面上被接缝卡住）
+// - 逐格检查是否仍然重叠，仍重叠则用解析方式推出并回调 OnExclusionSolid（与逐个方块对象时的回调语义一致）
+// - Bisection 模式的对象同样走这条路径：格子都是 AABB，解析推出即可得到刚好接触的位置
+CF_Manifold BaseObject::ExclusionWithTiles(const ObjManager::ObjToken& oth, const TileLayer& tiles) noexcept
+{
+    struct CellHit { CF_Aabb box; float area; };
+    // 每次调用独立的缓冲：回调 OnExclusionSolid 可能移动对象并再次进入这里，不能共用静态缓冲。
+    // 通常只重叠少数几个格子，放在栈上的固定数组里；超出时才整体搬到堆上
+    std::array<CellHit, 16> inline_cells;
+    std::vector<CellHit> heap_cells;
+    size_t count = 0;
+
+    const CF_Aabb self_box = shape_wrapper_to_aabb(GetShape());
+    tiles.ForEachSolidCell(self_box, [&](int, int, const CF_Aabb& cell) {
+        const float w = std::min(self_box.max.x, cell.max.x) - std::max(self_box.min.x, cell.min.x);
+        const float h = std::min(self_box.max.y, cell.max.y) - std::max(self_box.min.y, cell.min.y);
+        if (!(w > 0.0f && h > 0.0f)) return;
+        if (count < inline_cells.size()) {
+            inline_cells[count++] = { cell, w * h };
+            return;
+        }
+        if (heap_cells.empty()) heap_cells.assign(inline_cells.begin(), inline_cells.end());
+        heap_cells.push_back({ cell, w * h });
+        ++count;
+    });
+    CellHit* cells = heap_cells.empty() ? inline_cells.data() : heap_cells.data();
+    std::sort(cells, cells + count, [](const CellHit& a, const CellHit& b) { return a.area > b.area; });
+
+    for (size_t k = 0; k < count; ++k) {
+        const CellHit& c = cells[k];
+        if (!m_exclude_with_solid) break; // 回调中可能关闭排斥（例如血液落地后静止）
+        const CF_ShapeWrapper cell = CF_ShapeWrapper::FromAabb(c.box);
+        CF_Manifold m{};
+        if (!CollideWithShape(cell, m)) continue;
+        m = ResolveSolidShapeAnalytic(cell);
+        OnExclusionSolid(oth, m);
+    }
+
+    CF_Manifold result{};
+    tiles.CollideShape(GetShape(), &result);
+    return result;
+}
+
 void BaseObject::FindContactPos(CF_V2 current, CF_V2 offset, const BaseObject& other, CF_Manifold& res) {
     CF_V2 cur = current;
     CF_V2 side = cur - offset;
@@ -183,8 +404,14 @@ APPLIANCE void BaseObject::OnCollisionState(const ObjManager::ObjToken& other, c
     if (m_exclude_with_solid && 
         objs[other].GetColliderType() == ColliderType::SOLID) 
     {
-        m = ExclusionWithSolid(other, manifold);
-        OnExclusionSolid(other, m);
+        if (const TileLayer* tiles = objs[other].as_tile_layer()) {
+            // TileLayer：逐格求解，OnExclusionSolid 在 ExclusionWithTiles 内按格子回调
+            m = ExclusionWithTiles(other, *tiles);
+        }
+        else {
+            m = ExclusionWithSolid(other, manifold);
+            OnExclusionSolid(other, m);
+        }
     }
 
     switch (phase) {
@@ -208,6 +435,9 @@ BaseObject::~BaseObject() noexcept
     OnDestroy();
     DrawingSequence::Instance().Unregister(this);
     if (!m_sprite_path.empty()) {
-        cf_easy_sprite_unload(&m_sprite);
+        SpriteCache::Instance().Release(m_sprite_path);
+    }
+    for (const AnimClip& clip : m_anim_clips) {
+        SpriteCache::Instance().Release(clip.path);
     }
 }
\ No newline at end of file
@@ -35,9 +35,12 @@ void ManifoldDrawDebug(const CF_Manifold& m) noexcept {
 void RenderBaseObjectCollisionDebug(const BaseObject* obj) noexcept
 {
     if (!obj || obj->GetColliderType() == ColliderType::VOID) return;
+    RenderShapeOutlineDebug(obj->GetShape());
+}
 
-    const CF_ShapeWrapper& s = obj->GetShape();
-
+// 实现：按形状类型绘制红色轮廓（DrawingSequence 的调试覆盖层直接使用记录下来的形状值）
+void RenderShapeOutlineDebug(const CF_ShapeWrapper& s) noexcept
+{
     // 使用红色并保存绘制状态
     cf_draw_push();
     cf_draw_push_color(cf_color_red());
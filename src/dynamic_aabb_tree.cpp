@@ -0,0 +1,259 @@
+#include "dynamic_aabb_tree.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+CF_Aabb Combine(const CF_Aabb& a, const CF_Aabb& b) noexcept
+{
+    CF_Aabb c;
+    c.min = cf_v2(std::min(a.min.x, b.min.x), std::min(a.min.y, b.min.y));
+    c.max = cf_v2(std::max(a.max.x, b.max.x), std::max(a.max.y, b.max.y));
+    return c;
+}
+
+// 以周长作为插入代价（2D 中与面积启发式等价且对细长物体更稳定）
+float Perimeter(const CF_Aabb& a) noexcept
+{
+    return 2.0f * ((a.max.x - a.min.x) + (a.max.y - a.min.y));
+}
+
+CF_Aabb Fatten(const CF_Aabb& a, float margin) noexcept
+{
+    CF_Aabb f;
+    f.min = cf_v2(a.min.x - margin, a.min.y - margin);
+    f.max = cf_v2(a.max.x + margin, a.max.y + margin);
+    return f;
+}
+
+}
+
+int32_t DynamicAabbTree::AllocateNode()
+{
+    if (free_list_ == kNull) {
+        nodes_.emplace_back();
+        return static_cast<int32_t>(nodes_.size() - 1);
+    }
+    const int32_t id = free_list_;
+    free_list_ = nodes_[id].next;
+    nodes_[id] = Node{};
+    return id;
+}
+
+void DynamicAabbTree::FreeNode(int32_t id) noexcept
+{
+    nodes_[id].height = -1;
+    nodes_[id].next = free_list_;
+    free_list_ = id;
+}
+
+int32_t DynamicAabbTree::CreateProxy(const CF_Aabb& aabb, uint64_t user_data, float margin)
+{
+    const int32_t id = AllocateNode();
+    Node& n = nodes_[id];
+    n.aabb = Fatten(aabb, margin);
+    n.user_data = user_data;
+    n.height = 0;
+    InsertLeaf(id);
+    ++proxy_count_;
+    return id;
+}
+
+void DynamicAabbTree::DestroyProxy(int32_t id) noexcept
+{
+    if (!IsProxy(id)) return;
+    RemoveLeaf(id);
+    FreeNode(id);
+    --proxy_count_;
+}
+
+bool DynamicAabbTree::MoveProxy(int32_t id, const CF_Aabb& aabb, float margin)
+{
+    if (Contains(nodes_[id].aabb, aabb)) return false;
+    RemoveLeaf(id);
+    nodes_[id].aabb = Fatten(aabb, margin);
+    InsertLeaf(id);
+    return true;
+}
+
+void DynamicAabbTree::Clear() noexcept
+{
+    nodes_.clear();
+    root_ = kNull;
+    free_list_ = kNull;
+    proxy_count_ = 0;
+}
+
+void DynamicAabbTree::InsertLeaf(int32_t leaf)
+{
+    if (root_ == kNull) {
+        root_ = leaf;
+        nodes_[leaf].parent = kNull;
+        return;
+    }
+
+    // 1) 自根向下寻找兄弟节点：比较"在此处新建父节点"与"继续下降到某个子节点"的周长增量
+    const CF_Aabb leaf_aabb = nodes_[leaf].aabb;
+    int32_t index = root_;
+    while (!nodes_[index].IsLeaf()) {
+        const Node& n = nodes_[index];
+        const float area = Perimeter(n.aabb);
+        const float combined_area = Perimeter(Combine(n.aabb, leaf_aabb));
+        const float cost = 2.0f * combined_area;
+        const float inheritance_cost = 2.0f * (combined_area - area);
+
+        auto descend_cost = [&](int32_t child) {
+            const Node& c = nodes_[child];
+            const float new_area = Perimeter(Combine(leaf_aabb, c.aabb));
+            return c.IsLeaf() ? new_area + inheritance_cost : (new_area - Perimeter(c.aabb)) + inheritance_cost;
+        };
+        const float cost1 = descend_cost(n.child1);
+        const float cost2 = descend_cost(n.child2);
+        if (cost < cost1 && cost < cost2) break;
+        index = cost1 < cost2 ? n.child1 : n.child2;
+    }
+    const int32_t sibling = index;
+
+    // 2) 新建父节点，接替兄弟节点原来的位置（AllocateNode 可能使 nodes_ 扩容，之后再取引用）
+    const int32_t old_parent = nodes_[sibling].parent;
+    const int32_t new_parent = AllocateNode();
+    Node& p = nodes_[new_parent];
+    p.parent = old_parent;
+    p.aabb = Combine(leaf_aabb, nodes_[sibling].aabb);
+    p.height = nodes_[sibling].height + 1;
+    p.child1 = sibling;
+    p.child2 = leaf;
+    nodes_[sibling].parent = new_parent;
+    nodes_[leaf].parent = new_parent;
+    if (old_parent == kNull) {
+        root_ = new_parent;
+    }
+    else if (nodes_[old_parent].child1 == sibling) {
+        nodes_[old_parent].child1 = new_parent;
+    }
+    else {
+        nodes_[old_parent].child2 = new_parent;
+    }
+
+    // 3) 向上修正高度与包围盒，沿途旋转保持平衡
+    index = nodes_[leaf].parent;
+    while (index != kNull) {
+        index = Balance(index);
+        Node& n = nodes_[index];
+        n.height = 1 + std::max(nodes_[n.child1].height, nodes_[n.child2].height);
+        n.aabb = Combine(nodes_[n.child1].aabb, nodes_[n.child2].aabb);
+        index = n.parent;
+    }
+}
+
+void DynamicAabbTree::RemoveLeaf(int32_t leaf) noexcept
+{
+    if (leaf == root_) {
+        root_ = kNull;
+        return;
+    }
+
+    // 父节点被移除，兄弟节点接替父节点的位置
+    const int32_t parent = nodes_[leaf].parent;
+    const int32_t grand_parent = nodes_[parent].parent;
+    const int32_t sibling = nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+    if (grand_parent == kNull) {
+        root_ = sibling;
+        nodes_[sibling].parent = kNull;
+        FreeNode(parent);
+        return;
+    }
+
+    if (nodes_[grand_parent].child1 == parent) nodes_[grand_parent].child1 = sibling;
+    else nodes_[grand_parent].child2 = sibling;
+    nodes_[sibling].parent = grand_parent;
+    FreeNode(parent);
+
+    int32_t index = grand_parent;
+    while (index != kNull) {
+        index = Balance(index);
+        Node& n = nodes_[index];
+        n.height = 1 + std::max(nodes_[n.child1].height, nodes_[n.child2].height);
+        n.aabb = Combine(nodes_[n.child1].aabb, nodes_[n.child2].aabb);
+        index = n.parent;
+    }
+}
+
+int32_t DynamicAabbTree::Balance(int32_t ia) noexcept
+{
+    Node& a = nodes_[ia];
+    if (a.IsLeaf() || a.height < 2) return ia;
+
+    const int32_t ib = a.child1;
+    const int32_t ic = a.child2;
+    Node& b = nodes_[ib];
+    Node& c = nodes_[ic];
+    const int32_t balance = c.height - b.height;
+
+    // 把较高的子节点提升为该子树的根，它的较高子节点留在原处，较矮的子节点交给 a
+    auto rotate_up = [&](int32_t iup, Node& up, Node& other, bool up_was_child2) {
+        const int32_t i1 = up.child1;
+        const int32_t i2 = up.child2;
+        Node& n1 = nodes_[i1];
+        Node& n2 = nodes_[i2];
+
+        up.child1 = ia;
+        up.parent = a.parent;
+        a.parent = iup;
+        if (up.parent == kNull) {
+            root_ = iup;
+        }
+        else if (nodes_[up.parent].child1 == ia) {
+            nodes_[up.parent].child1 = iup;
+        }
+        else {
+            nodes_[up.parent].child2 = iup;
+        }
+
+        const bool keep_first = n1.height > n2.height;
+        const int32_t ikeep = keep_first ? i1 : i2;
+        const int32_t igive = keep_first ? i2 : i1;
+        up.child2 = ikeep;
+        if (up_was_child2) a.child2 = igive;
+        else a.child1 = igive;
+        nodes_[igive].parent = ia;
+
+        a.aabb = Combine(other.aabb, nodes_[igive].aabb);
+        a.height = 1 + std::max(other.height, nodes_[igive].height);
+        up.aabb = Combine(a.aabb, nodes_[ikeep].aabb);
+        up.height = 1 + std::max(a.height, nodes_[ikeep].height);
+        return iup;
+    };
+
+    if (balance > 1) return rotate_up(ic, c, b, true);
+    if (balance < -1) return rotate_up(ib, b, c, false);
+    return ia;
+}
+
+bool DynamicAabbTree::RayHitsAabb(const CF_V2& p0, const CF_V2& d, const CF_Aabb& box, float max_t, float* out_t) noexcept
+{
+    float t0 = 0.0f;
+    float t1 = max_t;
+    const float origin[2] = { p0.x, p0.y };
+    const float dir[2] = { d.x, d.y };
+    const float lo[2] = { box.min.x, box.min.y };
+    const float hi[2] = { box.max.x, box.max.y };
+    for (int axis = 0; axis < 2; ++axis) {
+        if (std::fabs(dir[axis]) < 1e-12f) {
+            // 与该轴平行：起点必须在 slab 内
+            if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) return false;
+            continue;
+        }
+        const float inv = 1.0f / dir[axis];
+        float near_t = (lo[axis] - origin[axis]) * inv;
+        float far_t = (hi[axis] - origin[axis]) * inv;
+        if (near_t > far_t) std::swap(near_t, far_t);
+        t0 = std::max(t0, near_t);
+        t1 = std::min(t1, far_t);
+        if (t0 > t1) return false;
+    }
+    if (out_t) *out_t = t0;
+    return true;
+}
@@ -0,0 +1,273 @@
+#include "headless.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+
+#include "debug_config.h"
+#include "delegate.h"
+#include "base_physics.h"
+#include "drawing_sequence.h"
+#include "sprite_cache.h"
+#include "obj_manager.h"
+#include "UI_draw.h"
+#include "room_loader.h"
+#include "globalplayer.h"
+#include "input.h"
+#include "profiler.h"
+
+extern std::atomic<int> g_frame_count;
+extern Delegate<> main_thread_on_update;
+
+namespace {
+	// 与 main 中的窗口尺寸保持一致（世界原点位于窗口中心）
+	constexpr int kWindowWidth = 1152;
+	constexpr int kWindowHeight = 864;
+
+	struct KeyName {
+		const char* name;
+		CF_KeyButton key;
+	};
+
+	// 游戏逻辑用到的按键
+	constexpr KeyName kKeyNames[] = {
+		{ "A", CF_KEY_A }, { "B", CF_KEY_B }, { "D", CF_KEY_D }, { "I", CF_KEY_I },
+		{ "J", CF_KEY_J }, { "K", CF_KEY_K }, { "L", CF_KEY_L }, { "M", CF_KEY_M },
+		{ "N", CF_KEY_N }, { "O", CF_KEY_O }, { "R", CF_KEY_R }, { "S", CF_KEY_S },
+		{ "U", CF_KEY_U }, { "W", CF_KEY_W }, { "SPACE", CF_KEY_SPACE }, { "ESCAPE", CF_KEY_ESCAPE },
+	};
+
+	bool KeyFromName(const std::string& name, CF_KeyButton& out) noexcept
+	{
+		for (const KeyName& k : kKeyNames) {
+			if (name == k.name) {
+				out = k.key;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	double ElapsedMs(std::chrono::steady_clock::time_point since) noexcept
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - since).count();
+	}
+}
+
+namespace Headless {
+
+bool ParseArgs(int argc, char* argv[], Options& out) noexcept
+{
+	bool headless = false;
+	for (int i = 1; i < argc; ++i) {
+		const char* arg = argv[i];
+		const bool has_value = i + 1 < argc;
+		if (std::strcmp(arg, "--headless") == 0) {
+			headless = true;
+		}
+		else if (std::strcmp(arg, "--room") == 0 && has_value) {
+			out.room = argv[++i];
+		}
+		else if (std::strcmp(arg, "--frames") == 0 && has_value) {
+			const int n = std::atoi(argv[++i]);
+			if (n > 0) out.frames = n;
+		}
+		else if (std::strcmp(arg, "--input") == 0 && has_value) {
+			out.input_path = argv[++i];
+		}
+	}
+	return headless;
+}
+
+bool LoadInputScript(const std::string& path, std::vector<InputSpan>& out)
+{
+	out.clear();
+	std::ifstream file(path);
+	if (!file.is_open()) {
+		std::cerr << "[Headless] cannot open input script: " << path << std::endl;
+		return false;
+	}
+	std::string line;
+	int line_no = 0;
+	while (std::getline(file, line)) {
+		++line_no;
+		if (line.empty() || line[0] == '#') continue;
+		std::istringstream iss(line);
+		InputSpan span;
+		if (!(iss >> span.first >> span.last)) {
+			std::cerr << "[Headless] " << path << ":" << line_no << ": expected '<first> <last> <key>...'" << std::endl;
+			continue;
+		}
+		std::string name;
+		while (iss >> name) {
+			CF_KeyButton key;
+			if (KeyFromName(name, key)) span.keys.set(static_cast<size_t>(key));
+			else std::cerr << "[Headless] " << path << ":" << line_no << ": unknown key " << name << std::endl;
+		}
+		out.push_back(span);
+	}
+	return true;
+}
+
+std::vector<InputSpan> DefaultInputScript(int frames)
+{
+	std::vector<InputSpan> script;
+	InputSpan walk;
+	walk.first = 0;
+	walk.last = frames - 1;
+	walk.keys.set(static_cast<size_t>(CF_KEY_D));
+	script.push_back(walk);
+	for (int f = 0; f < frames; f += 40) {
+		InputSpan jump;
+		jump.first = f;
+		jump.last = f + 9;
+		jump.keys.set(static_cast<size_t>(CF_KEY_SPACE));
+		script.push_back(jump);
+	}
+	return script;
+}
+
+bool InitApp(const char* argv0, bool graphics)
+{
+	using namespace Cute;
+	// 隐藏窗口 + 无音频；默认同时关闭图形，只保留文件系统、输入与精灵数据
+	int options = CF_APP_OPTIONS_HIDDEN_BIT | CF_APP_OPTIONS_NO_AUDIO_BIT;
+	if (!graphics) options |= CF_APP_OPTIONS_NO_GFX_BIT;
+	CF_Result result = make_app("My I Wanna (headless)", 0, 0, 0, kWindowWidth, kWindowHeight, options, argv0);
+	if (is_error(result)) return false;
+
+	DrawUI::half_w = static_cast<float>(kWindowWidth) * 0.5f;
+	DrawUI::half_h = static_cast<float>(kWindowHeight) * 0.5f;
+	PhysicsSystem::Instance().SetWorldBounds(cf_make_aabb(cf_v2(-DrawUI::half_w, -DrawUI::half_h), cf_v2(DrawUI::half_w, DrawUI::half_h)));
+	{
+		CF_Path base = fs_get_base_directory();
+		base.normalize();
+		base += "/content";
+		LOG_INFO(Resource, { "VFS" }, "Mounting content directory:", base.c_str(), "-> virtual root \"\"");
+		fs_mount(base.c_str(), "");
+	}
+	DrawingSequence::Instance().SetRecordOnly(!graphics);
+	return true;
+}
+
+void ShutdownApp()
+{
+	Profiler::Instance().FinishCapture();
+	ObjManager::Instance().DestroyAll();
+	main_thread_on_update.clear();
+	SpriteCache::Instance().Clear();
+	Input::ClearScriptedKeys();
+	DrawingSequence::Instance().SetRecordOnly(false);
+	Cute::destroy_app();
+}
+
+Report Run(const Options& opt, const std::vector<InputSpan>& script)
+{
+	Report report;
+	RoomLoader& loader = RoomLoader::Instance();
+	if (!opt.room.empty() && loader.GetRoomByName(opt.room)) {
+		loader.Load(opt.room);
+		report.room = opt.room;
+	}
+	else {
+		if (!opt.room.empty()) std::cerr << "[Headless] unknown room '" << opt.room << "', loading initial room" << std::endl;
+		loader.LoadInitial();
+		report.room = loader.GetRoomName(loader.GetCurrentRoom()).value_or("<none>");
+	}
+
+	DrawingSequence& drawing = DrawingSequence::Instance();
+	const auto run_start = std::chrono::steady_clock::now();
+	for (int frame = 0; frame < opt.frames; ++frame) {
+		std::bitset<CF_KEY_COUNT> keys;
+		for (const InputSpan& span : script) {
+			if (frame >= span.first && frame <= span.last) keys |= span.keys;
+		}
+		Input::SetScriptedKeys(keys);
+
+		PROFILE_FRAME_MARK();
+		g_frame_count++;
+
+		auto t = std::chrono::steady_clock::now();
+		{
+			PROFILE_ZONE("main_thread_on_update");
+			main_thread_on_update();
+		}
+		report.delegates.Add(ElapsedMs(t));
+
+		t = std::chrono::steady_clock::now();
+		ObjManager::Instance().UpdateAll();
+		report.objects.Add(ElapsedMs(t));
+
+		t = std::chrono::steady_clock::now();
+		{
+			PROFILE_ZONE("RoomUpdate");
+			loader.UpdateCurrent();
+		}
+		report.room_update.Add(ElapsedMs(t));
+
+		// 与主循环一致：R 键重生
+		if (Input::IsKeyInState(CF_KEY_R, KeyState::Down)) {
+			if (GlobalPlayer::Instance().GetRespawnRoom()) {
+				GlobalPlayer::Instance().Revive();
+				++report.respawns;
+			}
+		}
+
+		t = std::chrono::steady_clock::now();
+		{
+			PROFILE_ZONE("DrawingSequence::DrawAll");
+			drawing.DrawAll();
+		}
+		report.draw.Add(ElapsedMs(t));
+		report.sprites_recorded += drawing.GetLastFrameSpriteCount();
+	}
+	report.wall_ms = ElapsedMs(run_start);
+	report.frames = opt.frames;
+	report.objects_at_end = ObjManager::Instance().Count();
+	return report;
+}
+
+void PrintReport(const Report& report, std::ostream& os)
+{
+	const double frames = report.frames > 0 ? static_cast<double>(report.frames) : 1.0;
+	const double fps = report.wall_ms > 0.0 ? report.frames * 1000.0 / report.wall_ms : 0.0;
+	os << std::fixed << std::setprecision(3);
+	os << "[Headless] room=" << report.room << " frames=" << report.frames
+		<< " wall=" << report.wall_ms << "ms fps=" << std::setprecision(1) << fps << std::setprecision(3) << "\n";
+	auto phase = [&](const char* name, const PhaseStats& p) {
+		os << "  " << std::left << std::setw(12) << name << std::right
+			<< " avg=" << p.total_ms / frames << "ms"
+			<< " max=" << p.max_ms << "ms"
+			<< " total=" << p.total_ms << "ms\n";
+	};
+	phase("delegates", report.delegates);
+	phase("objects", report.objects);
+	phase("room", report.room_update);
+	phase("draw(rec)", report.draw);
+	os << "  sprites/frame=" << static_cast<double>(report.sprites_recorded) / frames
+		<< " objects_at_end=" << report.objects_at_end
+		<< " respawns=" << report.respawns << std::endl;
+}
+
+int Main(const Options& opt, const char* argv0)
+{
+	std::vector<InputSpan> script;
+	if (opt.input_path.empty() || !LoadInputScript(opt.input_path, script)) {
+		script = DefaultInputScript(opt.frames);
+	}
+	if (!InitApp(argv0)) {
+		std::cerr << "[Headless] failed to create app" << std::endl;
+		return -1;
+	}
+	Report report = Run(opt, script);
+	PrintReport(report, std::cout);
+	ShutdownApp();
+	return 0;
+}
+
+}
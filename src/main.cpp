@@ -1,4 +1,5 @@
 #include <chrono>
+#include <cstdlib>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
@@ -9,11 +10,15 @@
 #include "debug_config.h"
 #include "delegate.h"
 #include "base_object.h"
+#include "base_physics.h"
 #include "drawing_sequence.h"
+#include "sprite_cache.h"
 #include "obj_manager.h"
 #include "UI_draw.h"
 #include "room_loader.h"
 #include "globalplayer.h"
+#include "headless.h"
+#include "profiler.h"
 
 // 全局变量：
 // 全局帧计数
@@ -31,9 +36,11 @@ extern Delegate<> main_thread_on_update;
 namespace {
 	void LogContainerMemorySnapshot(const char* phase)
 	{
-		OUTPUT({ "Memory" }, phase,
+		LOG_INFO(Memory, phase,
 			"DrawingSequence bytes=", DrawingSequence::Instance().GetEstimatedMemoryUsageBytes(),
 			"ObjManager bytes=", ObjManager::Instance().GetEstimatedMemoryUsageBytes(),
+			"SpriteCache bytes=", SpriteCache::Instance().GetEstimatedMemoryUsageBytes(),
+			"cached sprites=", SpriteCache::Instance().GetCachedCount(),
 			"RoomLoader bytes=", RoomLoader::Instance().GetEstimatedMemoryUsageBytes());
 	}
 }
@@ -41,10 +48,36 @@ namespace {
 int main(int argc, char* argv[])
 {
 	//--------------------------初始化应用程序--------------------------
-	OUTPUT({"Main"}, "----------Program Start----------");
+#if OUTPUT_DEBUG
+	// 日志类别过滤：--log-categories <类别,类别,...>（如 Physics,Room；all 为全部），在编译期掩码之上进一步筛选
+	for (int i = 1; i + 1 < argc; ++i) {
+		if (std::string(argv[i]) == "--log-categories") LogRuntimeMask().store(ParseLogCategoryList(argv[i + 1]));
+	}
+#endif
+	LOG_INFO(Main, "----------Program Start----------");
+	// 帧阶段分析：--profile-capture <帧数> [--profile-out <trace.json>]（需以 MCG_PROFILE=1 编译）
+	{
+		int capture_frames = 0;
+		std::string capture_path;
+		for (int i = 1; i + 1 < argc; ++i) {
+			if (std::string(argv[i]) == "--profile-capture") capture_frames = std::atoi(argv[i + 1]);
+			else if (std::string(argv[i]) == "--profile-out") capture_path = argv[i + 1];
+		}
+		if (capture_frames > 0) Profiler::Instance().RequestCapture(capture_frames, capture_path);
+	}
+	// 无窗口模拟模式：--headless [--room <name>] [--frames <n>] [--input <script>]
+	Headless::Options headless_options;
+	if (Headless::ParseArgs(argc, argv, headless_options)) {
+		const int exit_code = Headless::Main(headless_options, argv[0]);
+#if OUTPUT_DEBUG
+		// 与窗口模式相同：返回前等待日志写线程写完，CI 运行的日志末尾不会丢失
+		AsyncLogger::Instance().Flush();
+#endif
+		return exit_code;
+	}
 	using namespace Cute;
 	// 打印 debug 配置
-	OUTPUT({"Main"}, "MCG_DEBUG =", MCG_DEBUG, " MCG_DEBUG_LEVEL =", MCG_DEBUG_LEVEL);
+	LOG_INFO(Main, "MCG_DEBUG =", MCG_DEBUG, " MCG_DEBUG_LEVEL =", MCG_DEBUG_LEVEL);
 
 	// 窗口大小
 	int window_width = 1152;
@@ -58,12 +91,14 @@ int main(int argc, char* argv[])
 	// 记录窗口半宽高，用于 UI 绘制
 	DrawUI::half_w = static_cast<float>(window_width) * 0.5f;
 	DrawUI::half_h = static_cast<float>(window_height) * 0.5f;
+	// broadphase 稠密网格覆盖整个窗口（世界原点位于窗口中心）
+	PhysicsSystem::Instance().SetWorldBounds(cf_make_aabb(cf_v2(-DrawUI::half_w, -DrawUI::half_h), cf_v2(DrawUI::half_w, DrawUI::half_h)));
 	{
 		// 挂载 content 目录到虚拟根 "/"，使资源可用为 "/sprites/idle.png"
 		CF_Path base = fs_get_base_directory();
 		base.normalize();
 		base += "/content";
-		OUTPUT({"VFS"}, "Mounting content directory:", base.c_str(), "-> virtual root \"\"");
+		LOG_INFO(Resource, { "VFS" }, "Mounting content directory:", base.c_str(), "-> virtual root \"\"");
 		fs_mount(base.c_str(), "");
 	}
 
@@ -102,19 +137,29 @@ int main(int argc, char* argv[])
 	{
 		// 一次性日志：主循环成功启动，app_update 可用
 		static bool _once = false;
-		if (!_once) { OUTPUT({"LOOP"}, "app_update OK, current frame rate:", g_frame_rate); _once = true; }
+		if (!_once) { LOG_INFO(Main, { "LOOP" }, "app_update OK, current frame rate:", g_frame_rate); _once = true; }
 
 		//--------------------更新阶段--------------------
+		PROFILE_FRAME_MARK();
 		// 全局帧计数递增
 		g_frame_count++;
 		// 调用 Cute Framework 更新
-		app_update();
+		{
+			PROFILE_ZONE("app_update");
+			app_update();
+		}
 		// 调用主线程更新委托
-		main_thread_on_update(); 
+		{
+			PROFILE_ZONE("main_thread_on_update");
+			main_thread_on_update(); 
+		}
 		// 更新所有对象（物理积分/碰撞检测/行为更新等）
 		objs.UpdateAll();
 		// 更新当前房间
-		RoomLoader::Instance().UpdateCurrent();
+		{
+			PROFILE_ZONE("RoomUpdate");
+			RoomLoader::Instance().UpdateCurrent();
+		}
 		
 		// 处理 ESC 键：计时退出
 		if (cf_key_down(CF_KEY_ESCAPE))
@@ -144,19 +189,23 @@ int main(int argc, char* argv[])
 
 		// 按 R 键重生
 		if (Input::IsKeyInState(CF_KEY_R, KeyState::Down)) {
-			OUTPUT({ "Main" }, "R Pressed, start respawn process");
+			LOG_INFO(Main, "R Pressed, start respawn process");
 			LogContainerMemorySnapshot("BeforeRespawn");
-			RoomLoader::Instance().Load(*GlobalPlayer::Instance().GetRespawnRoom());
+			GlobalPlayer::Instance().Revive();
 			LogContainerMemorySnapshot("AfterRespawn");
 		}
 
 		//--------------------绘制阶段--------------------
 		try {
+			PROFILE_ZONE("DrawingSequence::DrawAll");
 			DrawingSequence::Instance().DrawAll();
 		} catch (const std::exception& ex) {
-			OUTPUT({"Draw"}, "绘制异常 (upload):", ex.what());
+			LOG_ERROR(DrawingSequence, { "Draw" }, "绘制异常 (upload):", ex.what());
 			break;
 		}
+		PROFILE_ZONE("UI+Present");
+		// 调试覆盖层（形状轮廓 / 碰撞流形），未开启调试宏时为空操作
+		DrawingSequence::Instance().DrawDebugOverlay();
 		// ---- 你当前的测试绘制（参考方形 / 文本 等） ----
 		DrawUI::on_draw_ui.invoke();
 		DrawUI::on_draw_ui.clear();
@@ -167,17 +216,25 @@ int main(int argc, char* argv[])
 		if (esc_was_down) { DrawUI::EscDraw(esc_down_start, esc_hold_threshold); }
 
 		app_draw_onto_screen(true);
-		}
+	}
 
 	// 程序退出：
+	// 导出尚未结束的分析捕获
+	Profiler::Instance().FinishCapture();
 	// 由控制器销毁所有对象
 	objs.DestroyAll();
 	// 清理主线程更新委托
 	main_thread_on_update.clear();
+	// 卸载缓存中的全部精灵
+	SpriteCache::Instance().Clear();
 	// 销毁背景音乐资源
 	cf_audio_destroy(g_background_music);
 	// 销毁应用程序
 	Cute::destroy_app();
-	OUTPUT({ "Main" }, "----------Program End----------");
+	LOG_INFO(Main, "----------Program End----------");
+#if OUTPUT_DEBUG
+	// 等待日志写线程把剩余记录写完
+	AsyncLogger::Instance().Flush();
+#endif
 	return 0;
 }
\ No newline at end of file
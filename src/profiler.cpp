@@ -0,0 +1,177 @@
+#include "profiler.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace {
+// 区段名写入 JSON 字符串：名字来自任意字面量或 typeid().name()（由编译器决定），需要转义引号、反斜杠与控制字符
+void WriteJsonString(std::ostream& os, const char* s)
+{
+    static const char kHex[] = "0123456789abcdef";
+    os << '"';
+    for (; *s; ++s) {
+        const unsigned char c = static_cast<unsigned char>(*s);
+        switch (c) {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if (c < 0x20) os << "\\u00" << kHex[c >> 4] << kHex[c & 0xF];
+            else os << static_cast<char>(c);
+            break;
+        }
+    }
+    os << '"';
+}
+}
+
+Profiler& Profiler::Instance() noexcept
+{
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() noexcept
+    : m_epoch(std::chrono::steady_clock::now())
+{
+}
+
+// 每个线程第一次记录时注册自己的缓冲；之后只访问 thread_local 指针，不再加锁
+Profiler::ThreadBuffer& Profiler::LocalBuffer() noexcept
+{
+    thread_local ThreadBuffer* local = nullptr;
+    if (!local) {
+        auto buffer = std::make_unique<ThreadBuffer>();
+        buffer->zones.resize(kRingCapacity);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        buffer->tid = static_cast<uint32_t>(m_buffers.size());
+        local = buffer.get();
+        m_buffers.push_back(std::move(buffer));
+    }
+    return *local;
+}
+
+void Profiler::Record(const char* name, uint64_t begin_ns, uint64_t end_ns) noexcept
+{
+    ThreadBuffer& buffer = LocalBuffer();
+    const uint64_t n = buffer.written.load(std::memory_order_relaxed);
+    Zone& z = buffer.zones[n & (kRingCapacity - 1)];
+    z.name = name;
+    z.begin_ns = begin_ns;
+    z.end_ns = end_ns;
+    buffer.written.store(n + 1, std::memory_order_release);
+}
+
+void Profiler::FrameMark() noexcept
+{
+    const uint64_t now = NowNs();
+    std::string path;
+    uint64_t begin = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        ++m_frame_index;
+        if (m_capture_active) {
+            m_frame_marks.push_back(now);
+            if (--m_capture_remaining > 0) return;
+            // 捕获窗口结束：本帧开始时间即为窗口终点
+            m_capture_active = false;
+            path = m_capture_path;
+            begin = m_capture_begin_ns;
+        }
+        else {
+            if (m_capture_requested > 0) {
+                m_capture_active = true;
+                m_capture_remaining = m_capture_requested;
+                m_capture_requested = 0;
+                m_capture_begin_ns = now;
+                m_frame_marks.clear();
+                m_frame_marks.push_back(now);
+            }
+            return;
+        }
+    }
+    ExportChromeTrace(path, begin, now);
+}
+
+void Profiler::RequestCapture(int frames, std::string path)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (frames <= 0 || m_capture_active) return;
+    m_capture_requested = frames;
+    m_capture_path = path.empty() ? std::string("profile_trace.json") : std::move(path);
+}
+
+void Profiler::FinishCapture() noexcept
+{
+    std::string path;
+    uint64_t begin = 0;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_capture_active) return;
+        m_capture_active = false;
+        path = m_capture_path;
+        begin = m_capture_begin_ns;
+    }
+    ExportChromeTrace(path, begin, NowNs());
+}
+
+// Chrome trace 格式：完整区段使用 "ph":"X"（ts/dur 单位为微秒），帧边界使用实例事件 "ph":"i"
+bool Profiler::ExportChromeTrace(const std::string& path, uint64_t begin_ns, uint64_t end_ns) const
+{
+    std::ofstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "[Profiler] cannot write trace: " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    file << std::fixed << std::setprecision(3);
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+    bool first = true;
+    size_t zone_count = 0;
+    size_t dropped = 0;
+    auto sep = [&]() -> std::ofstream& {
+        if (!first) file << ",\n";
+        first = false;
+        return file;
+    };
+
+    for (size_t i = 0; i < m_frame_marks.size(); ++i) {
+        sep() << "{\"name\":\"Frame\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":"
+            << static_cast<double>(m_frame_marks[i] - begin_ns) / 1000.0
+            << ",\"args\":{\"frame\":" << i << "}}";
+    }
+
+    for (const auto& buffer : m_buffers) {
+        const uint64_t written = buffer->written.load(std::memory_order_acquire);
+        const uint64_t count = std::min<uint64_t>(written, kRingCapacity);
+        bool window_start_seen = false;
+        for (uint64_t k = written - count; k < written; ++k) {
+            const Zone& z = buffer->zones[k & (kRingCapacity - 1)];
+            if (!z.name || z.end_ns < begin_ns || z.begin_ns > end_ns) continue;
+            if (k == written - count && written > kRingCapacity) window_start_seen = true;
+            // 跨越窗口边界的区段截断到窗口内，ts 与 dur 使用截断后的起止点
+            const uint64_t start_ns = std::max(z.begin_ns, begin_ns);
+            const uint64_t stop_ns = std::min(z.end_ns, end_ns);
+            sep() << "{\"name\":";
+            WriteJsonString(file, z.name);
+            file << ",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->tid
+                << ",\"ts\":" << static_cast<double>(start_ns - begin_ns) / 1000.0
+                << ",\"dur\":" << static_cast<double>(stop_ns - start_ns) / 1000.0 << '}';
+            ++zone_count;
+        }
+        // 环形缓冲的最旧区段仍落在窗口内：说明窗口开头的部分区段已被覆盖
+        if (window_start_seen) ++dropped;
+    }
+    file << "\n]}\n";
+
+    std::cerr << "[Profiler] wrote " << zone_count << " zones over " << m_frame_marks.size()
+        << " frames to " << path;
+    if (dropped) std::cerr << " (ring buffer wrapped on " << dropped << " thread(s); earliest zones lost)";
+    std::cerr << std::endl;
+    return true;
+}
@@ -0,0 +1,71 @@
+#include "room_arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+#include "base_object.h"
+#include "debug_config.h"
+
+void* RoomArena::Allocate(size_t bytes, size_t align)
+{
+    // 从当前块开始向后寻找放得下的块（Reset 后会依次复用已有的块）
+    for (; m_current < m_blocks.size(); ++m_current) {
+        Block& b = m_blocks[m_current];
+        const uintptr_t base = reinterpret_cast<uintptr_t>(b.data.get());
+        const uintptr_t aligned = (base + b.used + align - 1) & ~(static_cast<uintptr_t>(align) - 1);
+        const size_t offset = static_cast<size_t>(aligned - base);
+        if (offset + bytes <= b.size) {
+            b.used = offset + bytes;
+            return b.data.get() + offset;
+        }
+    }
+    // 没有可用的块：分配新块（超大对象单独占用一个块）
+    Block b;
+    b.size = std::max(kBlockBytes, bytes + align);
+    b.data = std::make_unique<std::byte[]>(b.size);
+    m_blocks.push_back(std::move(b));
+    m_current = m_blocks.size() - 1;
+    return Allocate(bytes, align);
+}
+
+void RoomArena::Destroy(BaseObject* p) noexcept
+{
+    if (!p) return;
+    p->~BaseObject();
+    if (m_live > 0) --m_live;
+}
+
+bool RoomArena::Reset() noexcept
+{
+    if (m_live != 0) {
+        LOG_WARN(ObjManager, "RoomArena::Reset skipped,", m_live, "objects still alive");
+        return false;
+    }
+    for (Block& b : m_blocks) b.used = 0;
+    m_current = 0;
+    return true;
+}
+
+size_t RoomArena::Trim() noexcept
+{
+    if (m_live != 0 || m_blocks.size() <= 1) return 0;
+    const size_t released = m_blocks.size() - 1;
+    m_blocks.resize(1);
+    m_blocks[0].used = 0;
+    m_current = 0;
+    return released;
+}
+
+size_t RoomArena::ReservedBytes() const noexcept
+{
+    size_t total = m_blocks.capacity() * sizeof(Block);
+    for (const Block& b : m_blocks) total += b.size;
+    return total;
+}
+
+size_t RoomArena::UsedBytes() const noexcept
+{
+    size_t total = 0;
+    for (const Block& b : m_blocks) total += b.used;
+    return total;
+}
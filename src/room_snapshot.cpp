@@ -0,0 +1,173 @@
+#include "room_snapshot.h"
+
+#include <algorithm>
+#include <unordered_set>
+
+#include "base_object.h"
+#include "debug_config.h"
+#include "profiler.h"
+#include "tile_layer.h"
+
+RoomSnapshot::State RoomSnapshot::Capture(const BaseObject& obj) noexcept
+{
+    State s;
+    s.position = obj.GetPosition();
+    s.velocity = obj.GetVelocity();
+    s.force = obj.GetForce();
+    s.rotation = obj.GetRotation();
+    s.scale_x = obj.GetScaleX();
+    s.scale_y = obj.GetScaleY();
+    s.depth = obj.GetDepth();
+    s.anim_clip = obj.GetCurrentAnimClip();
+    s.visible = obj.IsVisible();
+    s.collider_type = obj.GetColliderType();
+    s.collision_layer = obj.GetCollisionLayer();
+    s.sprite_path = obj.m_sprite_path;
+    s.sprite_frame_index = obj.m_sprite_current_frame_index;
+    if (const TileLayer* tiles = obj.as_tile_layer()) s.tiles = tiles->Cells();
+    return s;
+}
+
+void RoomSnapshot::ResetTransient(BaseObject& obj, const State& s) noexcept
+{
+    // 基础状态与快照一致，只需清掉帧间残留：上一帧位置、碰撞缓存与动画帧
+    obj.m_prev_position = obj.GetPosition();
+    obj.m_collide_manifolds.clear();
+    obj.m_sprite_current_frame_index = s.sprite_frame_index;
+}
+
+void RoomSnapshot::ApplyRecreated(BaseObject& obj, const State& s) noexcept
+{
+    // as_tile_layer 返回自身，说明 obj 就是 TileLayer
+    if (obj.as_tile_layer()) static_cast<TileLayer&>(obj).AssignCells(s.tiles);
+}
+
+void ObjManager::EnterRoomScope() noexcept
+{
+    if (room_scope_depth_++ > 0) return;
+    if (!room_snapshot_) room_snapshot_ = std::make_unique<RoomSnapshot>();
+    room_snapshot_->entries.clear();
+    room_snapshot_->captured = false;
+}
+
+void ObjManager::RecordRoomRecipe(const ObjToken& token, RoomRecipe recipe)
+{
+    if (!room_snapshot_) return;
+    room_snapshot_->entries.push_back(RoomSnapshot::Entry{ token, std::move(recipe), {} });
+}
+
+BaseObject* ObjManager::ResolveObject(ObjToken& token) noexcept
+{
+    if (!token.isValid()) return nullptr;
+    if (!token.isRegitsered) {
+        if (BaseObject* raw = FindPendingObject(token)) return raw;
+    }
+    if (!TryGetRegisteration(token)) return nullptr;
+    return objects_[token.index].ptr.get();
+}
+
+void ObjManager::CaptureRoomSnapshot() noexcept
+{
+    if (!room_snapshot_) return;
+    auto& entries = room_snapshot_->entries;
+    // RoomLoad 期间已被销毁的对象不进入快照
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [this](RoomSnapshot::Entry& e) {
+        BaseObject* obj = ResolveObject(e.token);
+        if (obj) e.state = RoomSnapshot::Capture(*obj);
+        return obj == nullptr;
+    }), entries.end());
+    room_snapshot_->captured = true;
+    LOG_TRACE(ObjManager, "CaptureRoomSnapshot: captured", entries.size(), "objects");
+}
+
+bool ObjManager::HasRoomSnapshot() const noexcept
+{
+    return room_snapshot_ && room_snapshot_->captured;
+}
+
+void ObjManager::ExcludeFromRoomSnapshot(const ObjToken& token) noexcept
+{
+    if (!room_snapshot_) return;
+    ObjToken target_token = token;
+    BaseObject* target = ResolveObject(target_token);
+    if (!target) return;
+    auto& entries = room_snapshot_->entries;
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [this, target](RoomSnapshot::Entry& e) {
+        return ResolveObject(e.token) == target;
+    }), entries.end());
+}
+
+bool ObjManager::RestoreRoomSnapshot() noexcept
+{
+    PROFILE_ZONE("ObjManager::RestoreRoomSnapshot");
+    if (!HasRoomSnapshot() || room_scope_depth_ > 0) return false;
+    auto& entries = room_snapshot_->entries;
+
+    // 1) 判定每个快照对象是保留还是重建；有对象需要重建却没有配方时放弃，此时尚未做任何修改
+    std::vector<BaseObject*> kept(entries.size(), nullptr);
+    std::unordered_set<const BaseObject*> keep_set;
+    keep_set.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        RoomSnapshot::Entry& entry = entries[i];
+        BaseObject* obj = ResolveObject(entry.token);
+        bool keep = obj && !obj->m_state_diverged;
+        if (keep && entry.token.isRegitsered) {
+            // 已排队等待销毁的对象同样视为偏离
+            const uint64_t key = (static_cast<uint64_t>(entry.token.index) << 32) | entry.token.generation;
+            keep = pending_destroy_set_.find(key) == pending_destroy_set_.end();
+        }
+        if (keep) keep = RoomSnapshot::Capture(*obj).SameAs(entry.state);
+        if (keep) {
+            kept[i] = obj;
+            keep_set.insert(obj);
+        }
+        else if (!entry.recipe) {
+            LOG_INFO(ObjManager, "RestoreRoomSnapshot: diverged object has no recipe, falling back to reload");
+            return false;
+        }
+    }
+
+    // 2) 立即销毁快照外与偏离的对象（子弹、血迹、玩家、被触发的陷阱……），不等到下一次 UpdateAll
+    pending_destroys_.clear();
+    pending_destroy_set_.clear();
+    std::vector<ObjToken> pending_tokens;
+    for (const PendingCreate& pc : pending_creates_) {
+        if (pc.ptr && !keep_set.count(pc.ptr.get()))
+            pending_tokens.push_back(ObjToken{ pc.slot, pending_slots_[pc.slot].generation, false });
+    }
+    for (const ObjToken& t : pending_tokens) DestroyPending(t);
+    size_t removed = pending_tokens.size();
+    for (uint32_t i = 0; i < objects_.size(); ++i) {
+        const Entry& e = objects_[i];
+        if (e.alive && e.ptr && !keep_set.count(e.ptr.get())) {
+            DestroyEntry(i);
+            ++removed;
+        }
+    }
+
+    // 3) 保留的对象原地复位；偏离的对象按配方重新创建（进入对象池，下一帧 UpdateAll 提交）
+    size_t recreated = 0;
+    for (size_t i = 0; i < entries.size(); ++i) {
+        RoomSnapshot::Entry& entry = entries[i];
+        if (kept[i]) {
+            RoomSnapshot::ResetTransient(*kept[i], entry.state);
+            continue;
+        }
+        try {
+            entry.token = entry.recipe(*this);
+            ++recreated;
+            // 写回配方之外的状态后重新记录：下次重生与重建出的对象比较，而不是与已不存在的旧对象比较
+            if (BaseObject* obj = ResolveObject(entry.token)) {
+                RoomSnapshot::ApplyRecreated(*obj, entry.state);
+                entry.state = RoomSnapshot::Capture(*obj);
+            }
+        }
+        catch (...) {
+            LOG_WARN(ObjManager, "RestoreRoomSnapshot: recreating object threw");
+            entry.token = ObjToken::Invalid();
+        }
+    }
+
+    LOG_INFO(ObjManager, "RestoreRoomSnapshot: kept", keep_set.size(), ", recreated", recreated, ", removed", removed);
+    return true;
+}
@@ -0,0 +1,88 @@
+#include "sprite_cache.h"
+#include "debug_config.h"
+#include "cute_sprite.h"
+
+SpriteCache& SpriteCache::Instance() noexcept
+{
+    static SpriteCache instance;
+    return instance;
+}
+
+CF_Sprite SpriteCache::Acquire(const std::string& path) noexcept
+{
+    auto it = m_entries.find(path);
+    if (it != m_entries.end()) {
+        ++it->second.refs;
+        return it->second.sprite;
+    }
+
+    CF_Sprite s = cf_make_easy_sprite_from_png(path.c_str(), nullptr);
+    if (!s.easy_sprite_id) {
+        LOG_WARN(Resource, { "SpriteCache" }, "Failed to load sprite:", path.c_str());
+        return cf_sprite_defaults();
+    }
+    Entry e;
+    e.sprite = s;
+    e.refs = 1;
+    m_entries.emplace(path, e);
+    LOG_TRACE(Resource, { "SpriteCache" }, "Loaded", path.c_str(), "cached =", m_entries.size());
+    return s;
+}
+
+void SpriteCache::Release(const std::string& path) noexcept
+{
+    auto it = m_entries.find(path);
+    if (it == m_entries.end()) return;
+    if (it->second.refs > 0) --it->second.refs;
+    if (it->second.refs == 0 && m_policy == ReleasePolicy::Immediate) {
+        cf_easy_sprite_unload(&it->second.sprite);
+        m_entries.erase(it);
+    }
+}
+
+void SpriteCache::ReleaseUnused() noexcept
+{
+    size_t released = 0;
+    for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+        if (it->second.refs == 0) {
+            cf_easy_sprite_unload(&it->second.sprite);
+            it = m_entries.erase(it);
+            ++released;
+        }
+        else {
+            ++it;
+        }
+    }
+    if (released) LOG_INFO(Resource, { "SpriteCache" }, "Released", released, "unused sprites, cached =", m_entries.size());
+}
+
+void SpriteCache::Clear() noexcept
+{
+    for (auto& kv : m_entries) {
+        cf_easy_sprite_unload(&kv.second.sprite);
+    }
+    m_entries.clear();
+}
+
+void SpriteCache::SetReleasePolicy(ReleasePolicy p) noexcept
+{
+    m_policy = p;
+    // 切换到立即释放时，顺带清掉已经无人使用的条目
+    if (m_policy == ReleasePolicy::Immediate) ReleaseUnused();
+}
+
+int SpriteCache::GetRefCount(const std::string& path) const noexcept
+{
+    auto it = m_entries.find(path);
+    return it == m_entries.end() ? 0 : it->second.refs;
+}
+
+size_t SpriteCache::GetEstimatedMemoryUsageBytes() const noexcept
+{
+    size_t total = m_entries.bucket_count() * sizeof(void*);
+    for (const auto& kv : m_entries) {
+        total += sizeof(kv) + kv.first.capacity();
+        total += static_cast<size_t>(kv.second.sprite.w) * static_cast<size_t>(kv.second.sprite.h) * 4; // RGBA 像素
+    }
+    return total;
+}
@@ -0,0 +1,124 @@
+#include "tile_layer.h"
+#include "dynamic_aabb_tree.h"
+#include "drawing_sequence.h"
+#include "sprite_cache.h"
+#include "cute_sprite.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// TileLayer：整张网格只注册一次物理与绘制，格子数据本身不产生任何对象
+
+TileLayer::~TileLayer() noexcept
+{
+    for (size_t i = 0; i < m_palette.size(); ++i) {
+        if (m_palette[i].easy_sprite_id) SpriteCache::Instance().Release(m_palette_paths[i]);
+    }
+    m_palette.clear();
+}
+
+void TileLayer::Start()
+{
+    SetCollisionLayer(CollisionLayer::Terrain);
+    SetColliderType(ColliderType::SOLID);
+    IsColliderRotate(false);
+    IsColliderApplyPivot(false);
+    SetDepth(0);
+
+    // 对象位置取网格中心，shape 为覆盖整张网格的包围盒
+    const CF_V2 half = cf_v2(m_cols * m_tile_size * 0.5f, m_rows * m_tile_size * 0.5f);
+    SetPosition(m_origin + half);
+    SetCenteredAabb(half.x, half.y);
+    SetStatic(true);
+
+    // 加载调色板：加载失败的条目保留为空 sprite，对应格子仍参与碰撞但不绘制
+    m_palette.reserve(m_palette_paths.size());
+    for (const std::string& path : m_palette_paths) {
+        CF_Sprite s = SpriteCache::Instance().Acquire(path);
+        if (!s.easy_sprite_id) LOG_WARN(Resource, { "TileLayer" }, "Failed to load tile sprite:", path.c_str());
+        m_palette.push_back(s);
+    }
+
+    DrawingSequence::Instance().Register(this);
+}
+
+bool TileLayer::SetTileAt(CF_V2 bottom_left, int sprite_index) noexcept
+{
+    const float fx = (bottom_left.x - m_origin.x) / m_tile_size;
+    const float fy = (bottom_left.y - m_origin.y) / m_tile_size;
+    const float rx = std::round(fx);
+    const float ry = std::round(fy);
+    if (std::fabs(fx - rx) > 1e-3f || std::fabs(fy - ry) > 1e-3f) return false;
+    const int cx = static_cast<int>(rx);
+    const int cy = static_cast<int>(ry);
+    if (!InRange(cx, cy)) return false;
+    SetTile(cx, cy, sprite_index);
+    return true;
+}
+
+bool TileLayer::CollideShape(const CF_ShapeWrapper& shape, CF_Manifold* out) const noexcept
+{
+    bool hit = false;
+    float best_depth = -1.0f;
+    CF_Manifold best{};
+    ForEachSolidCell(shape_wrapper_to_aabb(shape), [&](int, int, const CF_Aabb& cell) {
+        CF_Manifold m{};
+        if (shape.type == CF_SHAPE_TYPE_AABB) aabb_to_aabb_manifold(shape.u.aabb, cell, &m);
+        else cf_collide(&shape.u, nullptr, shape.type, &cell, nullptr, CF_SHAPE_TYPE_AABB, &m);
+        if (m.count <= 0) return;
+        const float d = m.count == 2 ? std::max(m.depths[0], m.depths[1]) : m.depths[0];
+        if (d > best_depth) {
+            best_depth = d;
+            best = m;
+            hit = true;
+        }
+    });
+    if (out) *out = hit ? best : CF_Manifold{};
+    return hit;
+}
+
+bool TileLayer::RayCast(CF_V2 from, CF_V2 to, float* fraction) const noexcept
+{
+    if (m_cols == 0 || m_rows == 0) return false;
+    const CF_V2 d = to - from;
+    if (std::fabs(d.x) < 1e-12f && std::fabs(d.y) < 1e-12f) return false;
+
+    // 先把线段裁剪到网格范围，从进入点所在的格子开始步进
+    CF_Aabb bounds{};
+    bounds.min = m_origin;
+    bounds.max = cf_v2(m_origin.x + m_cols * m_tile_size, m_origin.y + m_rows * m_tile_size);
+    float t = 0.0f;
+    if (!DynamicAabbTree::RayHitsAabb(from, d, bounds, 1.0f, &t)) return false;
+    const CF_V2 entry = from + d * t;
+    int cx = std::clamp(CellCoord(entry.x - m_origin.x), 0, m_cols - 1);
+    int cy = std::clamp(CellCoord(entry.y - m_origin.y), 0, m_rows - 1);
+
+    // 每个轴上到下一条格线的参数 t 与跨过一格所需的 t 增量
+    const float inf = std::numeric_limits<float>::infinity();
+    const int step_x = d.x > 0.0f ? 1 : (d.x < 0.0f ? -1 : 0);
+    const int step_y = d.y > 0.0f ? 1 : (d.y < 0.0f ? -1 : 0);
+    const float delta_x = step_x ? m_tile_size / std::fabs(d.x) : inf;
+    const float delta_y = step_y ? m_tile_size / std::fabs(d.y) : inf;
+    float next_x = step_x ? (m_origin.x + (cx + (step_x > 0 ? 1 : 0)) * m_tile_size - from.x) / d.x : inf;
+    float next_y = step_y ? (m_origin.y + (cy + (step_y > 0 ? 1 : 0)) * m_tile_size - from.y) / d.y : inf;
+
+    while (InRange(cx, cy)) {
+        if (m_cells[Index(cx, cy)] != kEmpty) {
+            if (fraction) *fraction = t;
+            return true;
+        }
+        if (next_x < next_y) {
+            if (next_x > 1.0f) break;
+            t = next_x;
+            cx += step_x;
+            next_x += delta_x;
+        }
+        else {
+            if (next_y > 1.0f) break;
+            t = next_y;
+            cy += step_y;
+            next_y += delta_y;
+        }
+    }
+    return false;
+}